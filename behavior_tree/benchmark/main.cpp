@@ -0,0 +1,127 @@
+#include <behavior_tree/bt_base.h>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+namespace {
+
+/// Inputs of the benchmark tree, flipped between ticks.
+struct World {
+  bool flags[4] = {true, false, true, false};
+  size_t actions = 0;
+};
+
+/// Builds a tree of the given depth with all control node types.
+BehaviorPtr make_tree(World &world, int depth, size_t &seed) {
+  if (depth == 0) {
+    size_t index = seed++ % 4;
+    if (seed % 3 == 0) {
+      return action([&world] { ++world.actions; });
+    }
+    return condition([&world, index] { return world.flags[index]; });
+  }
+  auto child = [&] { return make_tree(world, depth - 1, seed); };
+  switch (depth % 4) {
+  case 0:
+    return sequence(child(), not_(child()), child());
+  case 1:
+    return fallback(child(), child(), child());
+  case 2:
+    return sequence_memory(child(), if_then_else("", child(), child(),
+                                                 child()));
+  default:
+    return parallel(fallback_memory(child(), child()), child());
+  }
+}
+
+/// Returns nanoseconds per tick of the given tick function.
+double measure(const std::function<Status()> &tick, World &world, int ticks) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ticks; ++i) {
+    world.flags[i % 4] = !world.flags[i % 4];
+    tick();
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ticks;
+}
+
+/// An observer which does nothing, to measure the cost of observing.
+class EmptyObserver : public TickObserver {
+public:
+  void on_enter(const BehaviorNode &) override {}
+  void on_exit(const BehaviorNode &, Status) override {}
+};
+
+/// Returns nanoseconds per node visit of a sequence of many leaves.
+double measure_visits(BehaviorTree &tree, size_t leaves, int ticks) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ticks; ++i) {
+    tree.run();
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ticks / (leaves + 1);
+}
+
+/// Builds a sequence of conditions which all succeed.
+BehaviorPtr make_wide_tree(size_t leaves) {
+  BehaviorNode::Children children;
+  for (size_t i = 0; i < leaves; ++i) {
+    children.push_back(condition([] { return true; }));
+  }
+  return std::make_shared<Sequence>("", children);
+}
+
+} // namespace
+
+int main() {
+  constexpr int depth = 7;
+  constexpr int ticks = 20000;
+
+  World virtual_world;
+  size_t virtual_seed = 0;
+  BehaviorTree bt(make_tree(virtual_world, depth, virtual_seed));
+
+  World flat_world;
+  size_t flat_seed = 0;
+  FlatTree flat(make_tree(flat_world, depth, flat_seed));
+
+  double virtual_ns = measure([&bt] { return bt.run(); }, virtual_world, ticks);
+  double flat_ns = measure([&flat] { return flat.run(); }, flat_world, ticks);
+
+  std::printf("nodes: %zu, ticks: %d\n", flat.size(), ticks);
+  std::printf("virtual dispatch: %10.1f ns/tick\n", virtual_ns);
+  std::printf("flat dispatch:    %10.1f ns/tick (%.2fx)\n", flat_ns,
+              virtual_ns / flat_ns);
+
+  // Cost of the observers per node visit
+  constexpr size_t leaves = 1000;
+  constexpr int wide_ticks = 2000;
+  BehaviorTree wide(make_wide_tree(leaves));
+  double plain_ns = measure_visits(wide, leaves, wide_ticks);
+  auto empty = std::make_shared<EmptyObserver>();
+  wide.add_observer(empty);
+  double empty_ns = measure_visits(wide, leaves, wide_ticks);
+  wide.remove_observer(empty);
+  MetricsRegistry registry;
+  wide.enable_metrics("wide", registry);
+  double metrics_ns = measure_visits(wide, leaves, wide_ticks);
+  wide.disable_metrics();
+  auto subscription = wide.subscribe(nullptr, 16);
+  double transitions_ns = measure_visits(wide, leaves, wide_ticks);
+  wide.unsubscribe(subscription);
+
+  std::printf("visits: %zu per tick\n", leaves + 1);
+  std::printf("no observers:     %10.1f ns/visit\n", plain_ns);
+  std::printf("empty observer:   %10.1f ns/visit (+%.1f)\n", empty_ns,
+              empty_ns - plain_ns);
+  std::printf("metrics:          %10.1f ns/visit (+%.1f over empty)\n",
+              metrics_ns, metrics_ns - empty_ns);
+  std::printf("transitions:      %10.1f ns/visit (+%.1f over empty)\n",
+              transitions_ns, transitions_ns - empty_ns);
+  return virtual_world.actions == flat_world.actions ? 0 : 1;
+}
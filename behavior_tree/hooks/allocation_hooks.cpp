@@ -0,0 +1,126 @@
+// Replaces the global allocation functions so that AllocationGuard sees every
+// allocation made through operator new. Built as the separate static library
+// behavior_tree_allocation_hooks, which only executables that want the guard
+// link.
+
+#include "behavior_tree/real_time.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+/**
+ * @brief Allocates memory, reporting it to the current allocation guard.
+ *
+ * @param size The number of bytes.
+ * @param alignment The alignment, or 0 for the default one.
+ * @return void* The memory, or nullptr if there is not enough.
+ */
+void *allocate(std::size_t size, std::size_t alignment = 0) noexcept {
+  evo::behavior::AllocationGuard::record();
+  if (size == 0) {
+    size = 1;
+  }
+  if (alignment <= alignof(std::max_align_t)) {
+    return std::malloc(size);
+  }
+  void *memory = nullptr;
+  return posix_memalign(&memory, alignment, size) == 0 ? memory : nullptr;
+}
+
+/**
+ * @brief Allocates memory, calling the new handler until it succeeds.
+ *
+ * @param size The number of bytes.
+ * @param alignment The alignment, or 0 for the default one.
+ * @return void* The memory.
+ * @throws std::bad_alloc If there is not enough memory and no new handler.
+ */
+void *allocate_or_throw(std::size_t size, std::size_t alignment = 0) {
+  for (;;) {
+    if (void *memory = allocate(size, alignment)) {
+      return memory;
+    }
+    auto handler = std::get_new_handler();
+    if (!handler) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+} // namespace
+
+void *operator new(std::size_t size) { return allocate_or_throw(size); }
+
+void *operator new[](std::size_t size) { return allocate_or_throw(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete[](void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+
+void operator delete[](void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t, std::align_val_t) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t,
+                     const std::nothrow_t &) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+  std::free(memory);
+}
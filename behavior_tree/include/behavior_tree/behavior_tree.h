@@ -1,8 +1,23 @@
 #pragma once
 
+#include "clock.h"
+#include "interrupts.h"
+#include "load_shedder.h"
+#include "metrics.h"
+#include "node_index.h"
+#include "nodes/condition.h"
 #include "nodes/behavior_node.h" // Ensure correct path to the behavior node header
 #include "nodes/status.h" // Include the Status class for handling node statuses
+#include "real_time.h"
+#include "thread_pool.h"
+#include "tick_context.h"
+#include "tick_observer.h"
+#include "transition_stream.h"
+#include <any>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace evo::behavior {
 
@@ -40,14 +55,295 @@ public:
    */
   Status run();
 
+  /**
+   * @brief Runs the behavior tree within a time budget.
+   *
+   * The traversal stops before ticking the next node once the budget is spent
+   * and resumes from the same node on the next run() call, budgeted or not.
+   * At least one leaf node is ticked per call, so the traversal always
+   * advances.
+   *
+   * @param budget The time the traversal may take.
+   * @return Status The status of the behavior tree execution, or
+   * Status::Incomplete if the budget was spent before the traversal finished.
+   */
+  Status run(Clock::Duration budget);
+
+  /**
+   * @brief Sets the clock used to measure tick budgets and to sample the time
+   * of each tick.
+   *
+   * @param clock The clock to use.
+   */
+  void set_clock(ClockPtr clock);
+
+  /**
+   * @brief Sets data the nodes can reach through the tick's context.
+   *
+   * @param user_data The user data.
+   */
+  void set_user_data(std::any user_data);
+
+  /**
+   * @brief Returns the context of the latest tick, which holds the tick
+   * counter.
+   *
+   * @return const TickContext& The tick's context.
+   */
+  const TickContext &context() const;
+
+  /**
+   * @brief Enables load shedding: while recent ticks take too long, nodes with
+   * a priority below the policy's threshold are skipped.
+   *
+   * @param policy Settings of load shedding.
+   */
+  void set_load_shedding(const LoadSheddingPolicy &policy);
+
+  /**
+   * @brief Disables load shedding.
+   */
+  void disable_load_shedding();
+
+  /**
+   * @brief Returns the load shedder, which exposes the load and shed counts.
+   *
+   * @return const LoadShedder* The load shedder, or nullptr if load shedding is
+   * disabled.
+   */
+  const LoadShedder *load_shedder() const;
+
+  /**
+   * @brief Enables two-phase ticks: first all the prefetchable conditions of
+   * the tree are evaluated as a batch across the pool, then the tree is ticked
+   * and resolves those conditions from the batch results, running only the
+   * chosen actions.
+   *
+   * The conditions are collected now and again by set_root(); call this
+   * function again after changing the tree otherwise.
+   *
+   * @param pool The pool evaluating the conditions.
+   * @param snapshot Called before each batch, e.g. to take a snapshot of the
+   * data the conditions read.
+   */
+  void set_prefetching(std::shared_ptr<ThreadPool> pool,
+                       std::function<void()> snapshot = {});
+
+  /**
+   * @brief Disables two-phase ticks.
+   */
+  void disable_prefetching();
+
+  /**
+   * @brief Returns the index numbering the nodes of the tree, which the
+   * tree's metrics and transition subscriptions share. Pass it to other
+   * observers, e.g. a StatusPublisher, to keep their lookups hash-free.
+   *
+   * The index is built on first use and again by set_root().
+   *
+   * @return std::shared_ptr<const NodeIndex> The index.
+   */
+  std::shared_ptr<const NodeIndex> node_index();
+
+  /**
+   * @brief Registers an observer which is notified around every node ticked
+   * by run(), including the root.
+   *
+   * @param observer The observer to add.
+   */
+  void add_observer(std::shared_ptr<TickObserver> observer);
+
+  /**
+   * @brief Unregisters an observer.
+   *
+   * @param observer The observer to remove.
+   */
+  void remove_observer(const std::shared_ptr<TickObserver> &observer);
+
+  /**
+   * @brief Subscribes to the status transitions of the nodes of a subtree.
+   *
+   * Only changes are reported: an event is emitted when a node returns a
+   * status other than the one it returned the last time it was ticked, and
+   * the first time it is ticked. Subscribe and unsubscribe between ticks;
+   * events may be popped from another thread at any time.
+   *
+   * @param subtree The subtree to report, nullptr for the whole tree, which
+   * keeps being reported after set_root().
+   * @param capacity The number of events the subscription's queue holds.
+   * @return std::shared_ptr<TransitionSubscription> The subscription.
+   */
+  std::shared_ptr<TransitionSubscription>
+  subscribe(BehaviorPtr subtree = nullptr, std::size_t capacity = 1024);
+
+  /**
+   * @brief Cancels a subscription.
+   *
+   * @param subscription The subscription.
+   */
+  void unsubscribe(const std::shared_ptr<TransitionSubscription> &subscription);
+
+  /**
+   * @brief Counts the ticks of the tree, their durations and the visits and
+   * statuses of each node, and exposes them through a metrics registry.
+   *
+   * The counters start from zero and are reset by set_root().
+   *
+   * @param name The name of the tree, used as the tree label.
+   * @param registry The registry the metrics are added to.
+   * @return std::shared_ptr<TreeMetrics> The tree's metrics.
+   */
+  std::shared_ptr<TreeMetrics>
+  enable_metrics(const std::string &name,
+                 MetricsRegistry &registry = MetricsRegistry::global());
+
+  /**
+   * @brief Stops counting and removes the tree's metrics from their registry.
+   */
+  void disable_metrics();
+
+  /**
+   * @brief Adds a subtree which is ticked as soon as possible after its
+   * interrupt is triggered, from any thread.
+   *
+   * While the tree is being ticked, the interrupt preempts the traversal at
+   * the next node boundary; otherwise a service thread ticks it right away.
+   * The tree and its interrupt subtrees are never ticked at the same time.
+   * Interrupt subtrees must not be part of the tree. May be called from any
+   * thread; waits for a running tick to finish.
+   *
+   * @param subtree The subtree.
+   * @param policy Settings of the interrupt.
+   * @return std::shared_ptr<Interrupt> The interrupt, used to trigger it and to
+   * read its latencies.
+   */
+  std::shared_ptr<Interrupt> add_interrupt(BehaviorPtr subtree,
+                                           const InterruptPolicy &policy = {});
+
+  /**
+   * @brief Removes an interrupt subtree. May be called from any thread;
+   * waits for a running tick to finish.
+   *
+   * @param interrupt The interrupt.
+   */
+  void remove_interrupt(const std::shared_ptr<Interrupt> &interrupt);
+
+  /**
+   * @brief Runs the interrupt service thread with a real-time priority
+   * (SCHED_FIFO).
+   *
+   * @param priority The priority, or 0 for the default scheduling.
+   * @return true if the priority was applied, false if it was not permitted.
+   */
+  bool set_interrupt_thread_priority(int priority);
+
+  /**
+   * @brief Enables real-time mode: ticks are expected not to allocate.
+   *
+   * Every node of the tree preallocates its per-tick storage now, including
+   * the subtrees of lazy nodes, the scratch arena is reserved and memory is
+   * locked and faulted in as the policy requests. Call this from the thread
+   * which ticks the tree, after building the tree. During run(), an
+   * AllocationGuard counts the allocations of the ticking thread or aborts.
+   *
+   * @param policy Settings of real-time mode.
+   * @return true if the memory could be locked or locking was not requested.
+   */
+  bool set_real_time(const RealTimePolicy &policy = {});
+
+  /**
+   * @brief Disables real-time mode.
+   */
+  void disable_real_time();
+
+  /**
+   * @brief Returns the number of allocations made by ticks in real-time mode.
+   *
+   * @return std::uint64_t The number of allocations.
+   */
+  std::uint64_t tick_allocations() const;
+
   /**
    * @brief Virtual destructor to ensure proper cleanup in derived classes.
    */
   virtual ~BehaviorTree() = default;
 
 private:
+  /**
+   * @brief Ticks the root node under the configured traversal control.
+   *
+   * @param deadline The end of the tick's budget, if any.
+   * @return Status The status of the root node.
+   */
+  Status tick(std::optional<Clock::TimePoint> deadline);
+
+  /**
+   * @brief Ticks the root node under the traversal control, once the tick's
+   * context is installed.
+   *
+   * @param deadline The end of the tick's budget, if any.
+   * @param interrupts The interrupt service polled at node boundaries, if any.
+   * @return Status The status of the root node.
+   */
+  Status tick_controlled(std::optional<Clock::TimePoint> deadline,
+                         InterruptService *interrupts);
+
+  /**
+   * @brief Ticks the root node, evaluating the prefetchable conditions first
+   * if prefetching is enabled.
+   *
+   * @return Status The status of the root node.
+   */
+  Status tick_root();
+
+  /**
+   * @brief Ticks the root node, notifying the observers around it.
+   *
+   * @return Status The status of the root node.
+   */
+  Status tick_observed();
+
+  /**
+   * @brief Collects the prefetchable conditions of the tree.
+   */
+  void collect_prefetchable();
+
   /// The root node of the behavior tree.
   BehaviorPtr root_;
+  /// The clock used to measure tick budgets.
+  ClockPtr clock_ = default_clock();
+  /// The load shedder, if load shedding is enabled.
+  std::optional<LoadShedder> shedder_;
+  /// The pool evaluating conditions, if prefetching is enabled.
+  std::shared_ptr<ThreadPool> prefetch_pool_;
+  /// Called before each batch of prefetched conditions.
+  std::function<void()> snapshot_;
+  /// The prefetchable conditions of the tree.
+  std::vector<std::shared_ptr<Condition>> prefetchable_;
+  /// Numbers the nodes of the tree, built on first use.
+  std::shared_ptr<const NodeIndex> node_index_;
+  /// The registered observers.
+  std::vector<std::shared_ptr<TickObserver>> observers_;
+  /// Raw pointers to the registered observers, as passed to TickControl.
+  std::vector<TickObserver *> observer_ptrs_;
+  /// Detects transitions for the subscriptions, if there are any.
+  std::shared_ptr<TransitionTracker> transitions_;
+  /// The tree's metrics, if they are enabled.
+  std::shared_ptr<TreeMetrics> metrics_;
+  /// The registry containing metrics_.
+  MetricsRegistry *metrics_registry_ = nullptr;
+  /// Data the nodes can reach through the tick's context.
+  std::any user_data_;
+  /// The context of the tick, installed while the tree runs.
+  TickContext context_;
+  /// Settings of real-time mode, if it is enabled.
+  std::optional<RealTimePolicy> real_time_;
+  /// The number of allocations made by ticks in real-time mode.
+  std::uint64_t tick_allocations_ = 0;
+  /// Services the interrupt subtrees. Created with the tree, so ticks never
+  /// race its creation with add_interrupt().
+  std::unique_ptr<InterruptService> interrupts_ =
+      std::make_unique<InterruptService>();
 };
 
 } // namespace evo::behavior
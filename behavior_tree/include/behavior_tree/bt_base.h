@@ -2,4 +2,7 @@
 
 #include "behavior_tree.h"
 #include "bt_factory.h"
+#include "clock.h"
+#include "codegen.h"
+#include "flat_tree.h"
 #include "nodes/status.h"
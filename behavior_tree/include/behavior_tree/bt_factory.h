@@ -1,18 +1,31 @@
 #pragma once
 
 #include "nodes/action.h"
+#include "nodes/boolean_formula.h"
 #include "nodes/condition.h"
+#include "nodes/decorators/cached.h"
+#include "nodes/decorators/lazy.h"
 #include "nodes/decorators/not.h"
+#include "nodes/decorators/throttle.h"
+#include "nodes/dynamic_fallback.h"
+#include "nodes/dynamic_sequence.h"
 #include "nodes/fallback.h"
 #include "nodes/fallback_memory.h"
+#include "nodes/for_each.h"
 #include "nodes/if_then.h"
 #include "nodes/if_then_else.h"
 #include "nodes/latch.h"
 #include "nodes/parallel.h"
+#include "nodes/procedural_fallback.h"
+#include "nodes/procedural_sequence.h"
 #include "nodes/sequence.h"
 #include "nodes/sequence_memory.h"
 #include "nodes/skipper.h"
 #include "nodes/try_else.h"
+#include "nodes/unordered_fallback.h"
+#include "nodes/unordered_sequence.h"
+#include "shared_blackboard.h"
+#include <memory>
 
 /**
  * @brief This namespace contains functions for creating all types of behavior
@@ -64,6 +77,19 @@ template <class... Args>
   return std::make_shared<Action>(behavior, description);
 }
 
+/**
+ * @brief Creates an action node whose behavior receives the tick's context.
+ *
+ * @param behavior An action the node should execute, taking the context.
+ * @param description A text description.
+ * @return BehaviorPtr An action node.
+ */
+[[nodiscard]] inline BehaviorPtr
+action(std::function<void(TickContext &)> behavior,
+       std::string const &description = "") {
+  return std::make_shared<Action>(std::move(behavior), description);
+}
+
 /**
  * @brief Creates a condition node with a Status-returning behavior.
  *
@@ -77,6 +103,61 @@ condition(std::function<Status()> behavior,
   return std::make_shared<Condition>(behavior, description);
 }
 
+/**
+ * @brief Creates a condition node whose behavior receives the tick's context.
+ *
+ * @param behavior A condition the node should check, taking the context and
+ * returning a Status.
+ * @param description A text description.
+ * @return BehaviorPtr A condition node.
+ */
+[[nodiscard]] inline BehaviorPtr
+condition(std::function<Status(TickContext &)> behavior,
+          std::string const &description = "") {
+  return std::make_shared<Condition>(std::move(behavior), description);
+}
+
+/**
+ * @brief Creates a condition node without side effects, which may be evaluated
+ * ahead of the tick when the tree prefetches conditions.
+ *
+ * @param behavior A condition the node should check, returning a Status.
+ * @param description A text description.
+ * @return BehaviorPtr A prefetchable condition node.
+ */
+[[nodiscard]] inline BehaviorPtr
+prefetchable_condition(std::function<Status()> behavior,
+                       std::string const &description = "") {
+  auto node = std::make_shared<Condition>(behavior, description);
+  node->set_prefetchable(true);
+  return node;
+}
+
+/**
+ * @brief Creates a condition node which tests the latest value of a slot of a
+ * shared blackboard. Reading has no side effects, so the node is
+ * prefetchable.
+ *
+ * @tparam T The type of the slot's value.
+ * @tparam Predicate A callable taking const T& and returning bool or Status.
+ * @param board The blackboard.
+ * @param slot The slot to read.
+ * @param predicate The test of the value.
+ * @param description A text description.
+ * @return BehaviorPtr A condition node.
+ */
+template <class T, class Predicate>
+[[nodiscard]] BehaviorPtr
+blackboard_condition(std::shared_ptr<const SharedBlackboard> board,
+                     BlackboardSlot<T> slot, Predicate predicate,
+                     std::string const &description = "") {
+  return prefetchable_condition(
+      [board = std::move(board), slot, predicate = std::move(predicate)] {
+        return Status(predicate(board->read(slot)));
+      },
+      description);
+}
+
 /**
  * @brief Creates a behavior node with a Status-returning behavior.
  *
@@ -167,6 +248,32 @@ template <class... Args>
   return std::make_shared<Parallel>(description, children);
 }
 
+/**
+ * @brief Creates a fallback node which reorders its children at runtime.
+ *
+ * @tparam Args BehaviorPtr.
+ * @param args A description and/or child nodes.
+ * @return BehaviorPtr An unordered fallback node.
+ */
+template <class... Args>
+[[nodiscard]] BehaviorPtr unordered_fallback(Args... args) {
+  auto [description, children] = make_children_array(args...);
+  return std::make_shared<UnorderedFallback>(description, children);
+}
+
+/**
+ * @brief Creates a sequence node which reorders its children at runtime.
+ *
+ * @tparam Args BehaviorPtr.
+ * @param args A description and/or child nodes.
+ * @return BehaviorPtr An unordered sequence node.
+ */
+template <class... Args>
+[[nodiscard]] BehaviorPtr unordered_sequence(Args... args) {
+  auto [description, children] = make_children_array(args...);
+  return std::make_shared<UnorderedSequence>(description, children);
+}
+
     /**
      * @brief Creates a latch node and the relevant unlatch one.
      *
@@ -180,6 +287,125 @@ template <class... Args>
   return {latch, latch->make_unlatcher()};
 }
 
+/**
+ * @brief Creates a lazy node, which builds its subtree when it is first
+ * ticked.
+ *
+ * @param builder Builds the subtree.
+ * @param description A text description.
+ * @param idle_timeout The time without ticks after which
+ * Lazy::release_idle() frees the subtree; zero to keep it forever.
+ * @param clock The clock used to measure the idle time.
+ * @return std::shared_ptr<Lazy> A lazy node.
+ */
+[[nodiscard]] inline std::shared_ptr<Lazy>
+lazy(Lazy::Builder builder, const std::string &description = "",
+     Clock::Duration idle_timeout = Clock::Duration::zero(),
+     ClockPtr clock = default_clock()) {
+  return std::make_shared<Lazy>(std::move(builder), description, idle_timeout,
+                                std::move(clock));
+}
+
+/**
+ * @brief Creates a dynamic sequence node, whose children may be changed at
+ * runtime.
+ *
+ * @tparam Args BehaviorPtr.
+ * @param args A description and/or the initial child nodes.
+ * @return std::shared_ptr<DynamicSequence> A dynamic sequence node.
+ */
+template <class... Args>
+[[nodiscard]] std::shared_ptr<DynamicSequence> dynamic_sequence(Args... args) {
+  auto [description, children] = make_children_array(args...);
+  return std::make_shared<DynamicSequence>(description, children);
+}
+
+/**
+ * @brief Creates a dynamic sequence node without children.
+ *
+ * @return std::shared_ptr<DynamicSequence> A dynamic sequence node.
+ */
+[[nodiscard]] inline std::shared_ptr<DynamicSequence> dynamic_sequence() {
+  return std::make_shared<DynamicSequence>("", BehaviorNode::Children{});
+}
+
+/**
+ * @brief Creates a dynamic fallback node, whose children may be changed at
+ * runtime.
+ *
+ * @tparam Args BehaviorPtr.
+ * @param args A description and/or the initial child nodes.
+ * @return std::shared_ptr<DynamicFallback> A dynamic fallback node.
+ */
+template <class... Args>
+[[nodiscard]] std::shared_ptr<DynamicFallback> dynamic_fallback(Args... args) {
+  auto [description, children] = make_children_array(args...);
+  return std::make_shared<DynamicFallback>(description, children);
+}
+
+/**
+ * @brief Creates a dynamic fallback node without children.
+ *
+ * @return std::shared_ptr<DynamicFallback> A dynamic fallback node.
+ */
+[[nodiscard]] inline std::shared_ptr<DynamicFallback> dynamic_fallback() {
+  return std::make_shared<DynamicFallback>("", BehaviorNode::Children{});
+}
+
+/**
+ * @brief Creates a procedural sequence node, a sequence with memory whose
+ * children are generated on demand.
+ *
+ * @param description A text description.
+ * @param count The number of children.
+ * @param generator Builds or recycles the subtree of a child.
+ * @param window The number of children kept instantiated.
+ * @return std::shared_ptr<ProceduralSequence> A procedural sequence node.
+ */
+[[nodiscard]] inline std::shared_ptr<ProceduralSequence>
+procedural_sequence(const std::string &description, std::size_t count,
+                    ProceduralComposite::Generator generator,
+                    std::size_t window = 1) {
+  return std::make_shared<ProceduralSequence>(description, count,
+                                              std::move(generator), window);
+}
+
+/**
+ * @brief Creates a procedural fallback node, a fallback with memory whose
+ * children are generated on demand.
+ *
+ * @param description A text description.
+ * @param count The number of children.
+ * @param generator Builds or recycles the subtree of a child.
+ * @param window The number of children kept instantiated.
+ * @return std::shared_ptr<ProceduralFallback> A procedural fallback node.
+ */
+[[nodiscard]] inline std::shared_ptr<ProceduralFallback>
+procedural_fallback(const std::string &description, std::size_t count,
+                    ProceduralComposite::Generator generator,
+                    std::size_t window = 1) {
+  return std::make_shared<ProceduralFallback>(description, count,
+                                              std::move(generator), window);
+}
+
+/**
+ * @brief Creates a for each node, which ticks one subtree per item of a
+ * collection and combines their results.
+ *
+ * @param description A text description.
+ * @param size Returns the number of items.
+ * @param item Builds the subtree of the item with the given index.
+ * @param policy How the results are combined and evaluated.
+ * @return BehaviorPtr A for each node.
+ */
+[[nodiscard]] inline BehaviorPtr for_each(const std::string &description,
+                                          ForEach::SizeFunction size,
+                                          ForEach::ItemFactory item,
+                                          ForEachPolicy policy = {}) {
+  return std::make_shared<ForEach>(description, std::move(size),
+                                   std::move(item), std::move(policy));
+}
+
 /**
  * @brief Creates a not node.
  *
@@ -190,6 +416,45 @@ template <class... Args>
   return std::make_shared<Not>(child);
 }
 
+/**
+ * @brief Creates a throttle node.
+ *
+ * @param child The child node to be ticked at most once per period.
+ * @param period The minimal time between two ticks of the child.
+ * @param clock The clock used to measure the period.
+ * @return BehaviorPtr A throttle node.
+ */
+[[nodiscard]] inline BehaviorPtr throttle(BehaviorPtr child,
+                                          Clock::Duration period,
+                                          ClockPtr clock = default_clock()) {
+  return std::make_shared<Throttle>(child, period, clock);
+}
+
+/**
+ * @brief Creates a cached node.
+ *
+ * @param child The child node whose terminal status is cached.
+ * @param ttl The time a terminal status stays valid.
+ * @param clock The clock used to expire the cached status.
+ * @return BehaviorPtr A cached node.
+ */
+[[nodiscard]] inline BehaviorPtr cached(BehaviorPtr child, Clock::Duration ttl,
+                                        ClockPtr clock = default_clock()) {
+  return std::make_shared<Cached>(child, ttl, clock);
+}
+
+/**
+ * @brief Sets the priority of a node for load shedding.
+ *
+ * @param priority The priority of the node and its subtree.
+ * @param node The node to annotate.
+ * @return BehaviorPtr The same node.
+ */
+[[nodiscard]] inline BehaviorPtr with_priority(int priority, BehaviorPtr node) {
+  node->set_priority(priority);
+  return node;
+}
+
 /**
  * @brief Creates a "try else" node.
  *
@@ -235,4 +500,15 @@ template <class... Args>
                                       else_node);
 }
 
+/**
+ * @brief Compiles a subtree of Condition, Not, Sequence and Fallback nodes into
+ * a boolean formula node.
+ *
+ * @param subtree The root of the subtree.
+ * @return BehaviorPtr A boolean formula node.
+ */
+[[nodiscard]] inline BehaviorPtr boolean_formula(const BehaviorPtr &subtree) {
+  return std::make_shared<BooleanFormula>(subtree);
+}
+
 } // namespace evo::behavior::bt_factory
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief Source of time for time-aware nodes.
+ *
+ * Nodes take the clock as a parameter instead of calling
+ * std::chrono::steady_clock directly, so that tests and simulations can
+ * substitute their own time source. Nodes whose behavior changes at a known
+ * time report it through add_deadline(), so that simulated clocks can skip
+ * the idle time in between.
+ */
+class Clock {
+public:
+  using Duration = std::chrono::steady_clock::duration;
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  /**
+   * @brief Virtual destructor for safe polymorphic use.
+   */
+  virtual ~Clock() = default;
+
+  /**
+   * @brief Returns the current time.
+   *
+   * @return TimePoint The current time.
+   */
+  virtual TimePoint now() const = 0;
+
+  /**
+   * @brief Tells the clock that a node's behavior changes at the given time,
+   * e.g. when a throttle lets its child run again. Clocks which do not skip
+   * time ignore it.
+   *
+   * @param deadline The time the behavior changes at.
+   */
+  virtual void add_deadline(TimePoint deadline);
+};
+
+using ClockPtr = std::shared_ptr<Clock>;
+
+/**
+ * @brief A clock which reads std::chrono::steady_clock.
+ */
+class SteadyClock : public Clock {
+public:
+  /**
+   * @brief Returns the current time of std::chrono::steady_clock.
+   *
+   * @return TimePoint The current time.
+   */
+  TimePoint now() const override;
+};
+
+/**
+ * @brief A clock whose time only moves when it is advanced, so that trees can
+ * be simulated faster than real time.
+ *
+ * Besides advancing by a step, the clock can jump to the earliest deadline
+ * reported by the nodes, skipping the time in which nothing would change.
+ * now() may be called from any thread.
+ */
+class SimulatedClock : public Clock {
+public:
+  /**
+   * @brief Constructs a new SimulatedClock object.
+   *
+   * @param start The initial time.
+   */
+  explicit SimulatedClock(TimePoint start = TimePoint());
+
+  /**
+   * @brief Returns the simulated time.
+   *
+   * @return TimePoint The current time.
+   */
+  TimePoint now() const override;
+
+  /**
+   * @brief Records a deadline to jump to.
+   *
+   * @param deadline The time a node's behavior changes at.
+   */
+  void add_deadline(TimePoint deadline) override;
+
+  /**
+   * @brief Moves the time forward.
+   *
+   * @param step The time to add.
+   * @throws std::invalid_argument If the step is negative.
+   */
+  void advance(Duration step);
+
+  /**
+   * @brief Moves the time forward to the given time.
+   *
+   * @param time The new time.
+   * @throws std::invalid_argument If the time is in the past.
+   */
+  void advance_to(TimePoint time);
+
+  /**
+   * @brief Returns the earliest deadline after the current time.
+   *
+   * @return std::optional<TimePoint> The deadline, or nothing if there is
+   * none.
+   */
+  std::optional<TimePoint> next_deadline() const;
+
+  /**
+   * @brief Moves the time forward to the earliest deadline after the current
+   * time.
+   *
+   * @param limit The time not to move past.
+   * @return true if the time moved to a deadline, false if there was none
+   * before the limit; the time is then moved to the limit.
+   */
+  bool advance_to_next_deadline(TimePoint limit = TimePoint::max());
+
+private:
+  /**
+   * @brief Drops the deadlines which are not after the given time. Requires
+   * mutex_.
+   *
+   * @param time The current time.
+   */
+  void drop_deadlines(TimePoint time) const;
+
+  /// The simulated time since the clock's epoch.
+  std::atomic<Duration::rep> now_;
+  /// Guards deadlines_ and the moves of the time.
+  mutable std::mutex mutex_;
+  /// The pending deadlines, earliest first.
+  mutable std::priority_queue<TimePoint, std::vector<TimePoint>,
+                              std::greater<TimePoint>>
+      deadlines_;
+};
+
+/**
+ * @brief Returns the clock used by time-aware nodes and trees unless another
+ * one is given.
+ *
+ * @return ClockPtr The clock set by set_default_clock(), a shared steady clock
+ * by default.
+ */
+ClockPtr default_clock();
+
+/**
+ * @brief Sets the clock used by time-aware nodes and trees created from now
+ * on unless another one is given, e.g. a SimulatedClock for a whole
+ * simulation.
+ *
+ * @param clock The clock, or nullptr to restore the steady clock.
+ */
+void set_default_clock(ClockPtr clock);
+
+} // namespace evo::behavior
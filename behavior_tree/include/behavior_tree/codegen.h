@@ -0,0 +1,70 @@
+#pragma once
+
+#include "nodes/behavior_node.h"
+#include <functional>
+#include <string>
+
+/**
+ * @brief This namespace contains functions for generating C++ code which ticks
+ * a fixed behavior tree without interpreting it.
+ *
+ * The generated header defines a state struct for the memory and latch nodes
+ * and a function template which ticks the tree:
+ *
+ *   template <class Leaves>
+ *   evo::behavior::Status tick_tree(tick_tree_state &state, Leaves &leaves);
+ *
+ * Leaf nodes become direct calls of Leaves member functions: conditions, as
+ * well as any nodes other than the built-in ones, call functions returning
+ * evo::behavior::Status, and actions call functions returning void. Exceptions
+ * thrown by leaves turn into Status::Failure as in Action and Condition.
+ */
+
+namespace evo::behavior::bt_codegen {
+
+/**
+ * @brief Settings of code generation.
+ */
+struct Options {
+  /// Name of the generated tick function, the state struct is named
+  /// <name>_state.
+  std::string name = "tick_tree";
+  /// Namespace of the generated code.
+  std::string name_space = "generated";
+  /// Returns the name of the Leaves member function which implements a leaf
+  /// node. By default the name is derived from the node's description.
+  std::function<std::string(const BehaviorNode &)> leaf_symbol;
+};
+
+/**
+ * @brief Generates a header which ticks the given tree.
+ *
+ * The header also defines <name>_check(fixture, ticks), which ticks the source
+ * tree and the generated function side by side and reports the first tick at
+ * which their statuses differ. The fixture must provide a `source` BehaviorPtr,
+ * a `leaves` object and a `prepare(int tick)` member function which sets
+ * identical inputs for both before each tick.
+ *
+ * @param root The root node of the tree.
+ * @param options Settings of code generation.
+ * @return std::string The generated header.
+ */
+std::string generate(const BehaviorPtr &root, const Options &options = {});
+
+/**
+ * @brief Generates a gtest source which checks the generated function against
+ * the source tree with <name>_check().
+ *
+ * @param header The include path of the generated header.
+ * @param fixture_header The include path of the header defining the fixture.
+ * @param fixture The name of the fixture type.
+ * @param options Settings of code generation, as passed to generate().
+ * @param ticks The number of ticks to compare.
+ * @return std::string The generated test source.
+ */
+std::string generate_test(const std::string &header,
+                          const std::string &fixture_header,
+                          const std::string &fixture,
+                          const Options &options = {}, int ticks = 1000);
+
+} // namespace evo::behavior::bt_codegen
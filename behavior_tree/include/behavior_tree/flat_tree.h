@@ -0,0 +1,225 @@
+#pragma once
+
+#include "nodes/behavior_node.h"
+#include "nodes/status.h"
+#include "tick_context.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief An alternative representation of a behavior tree which ticks built-in
+ * nodes without virtual calls.
+ *
+ * The tree is flattened into a contiguous array of tagged nodes, and a single
+ * switch dispatches on the tag. Built-in control nodes, actions and conditions
+ * are executed directly; any other node, e.g. a user-defined BehaviorNode, is
+ * kept as is and ticked through its virtual operator(), together with its
+ * subtree.
+ *
+ * The state of built-in control nodes is copied when the tree is flattened and
+ * is kept by the FlatTree afterwards, so tick either the FlatTree or the source
+ * nodes, not both. Tick budgets and load shedding are not supported.
+ *
+ * Copies of a FlatTree share the flattened structure and copy only the state,
+ * so fork() is cheap. Forks tick independently, except for nodes ticked
+ * through their virtual operator(), which remain shared.
+ */
+class FlatTree {
+public:
+  /**
+   * @brief Inputs and outputs of a dry-run tick.
+   */
+  struct DryRun {
+    /// Statuses returned by leaf nodes instead of ticking them, e.g.
+    /// hypothetical condition results or action outcomes. Conditions missing
+    /// here are evaluated.
+    std::unordered_map<const BehaviorNode *, Status> overlay;
+    /// The status actions are assumed to return.
+    Status action_status = Status::Success;
+    /// The status of nodes other than the built-in ones which are missing
+    /// from overlay.
+    Status opaque_status = Status::Failure;
+    /// The actions the tick would run, in order. Filled by dry_run().
+    std::vector<const BehaviorNode *> actions;
+  };
+
+  /**
+   * @brief Flattens the tree under the given root.
+   *
+   * @param root The root node of the tree.
+   */
+  explicit FlatTree(const BehaviorPtr &root);
+
+  /**
+   * @brief Ticks the tree.
+   *
+   * @return Status The status of the root node.
+   */
+  Status run();
+
+  /**
+   * @brief Ticks the tree without running actions or nodes other than the
+   * built-in ones: conditions are looked up in the overlay first, and actions
+   * are recorded instead of executed. The state of memory and latch nodes
+   * advances as in a real tick, so tick a fork() to keep this tree intact.
+   *
+   * @param dry_run The overlay, which also receives the recorded actions.
+   * @return Status The status the root node would return.
+   */
+  Status dry_run(DryRun &dry_run);
+
+  /**
+   * @brief Returns a copy of the tree's execution state which ticks
+   * independently of this tree.
+   *
+   * @return FlatTree The fork.
+   */
+  FlatTree fork() const;
+
+  /**
+   * @brief Resets the tree to its initial condition.
+   */
+  void reset();
+
+  /**
+   * @brief Returns the number of nodes in the tree.
+   *
+   * @return std::size_t The number of distinct nodes.
+   */
+  std::size_t size() const;
+
+private:
+  /// The kinds of nodes the flat tree executes directly.
+  enum class Kind : std::uint8_t {
+    SEQUENCE,
+    FALLBACK,
+    SEQUENCE_MEMORY,
+    FALLBACK_MEMORY,
+    PARALLEL,
+    SKIPPER,
+    LATCH,
+    NOT,
+    TRY_ELSE,
+    IF_THEN,
+    IF_THEN_ELSE,
+    ACTION,
+    CONDITION,
+    UNLATCH,
+    OPAQUE
+  };
+
+  /// Immutable description of a node.
+  struct Node {
+    /// The kind of the node.
+    Kind kind;
+    /// Position of the node's first child in children_.
+    std::uint32_t first_child;
+    /// Number of the node's children.
+    std::uint32_t child_count;
+    /// The node this node was flattened from.
+    BehaviorNode *source;
+    /// Index of the latch an unlatch node releases, or npos if the latch is
+    /// not part of this tree.
+    std::uint32_t target;
+  };
+
+  /// Immutable part of the tree, shared between forks.
+  struct Layout {
+    /// Nodes in depth-first order, the root first.
+    std::vector<Node> nodes;
+    /// Child indices of all nodes, each node's children are contiguous.
+    std::vector<std::uint32_t> children;
+    /// Keeps the source nodes alive.
+    std::vector<BehaviorPtr> sources;
+  };
+
+  /// Mutable state of a node.
+  struct NodeState {
+    /// The epoch of the latest reset which reached this node.
+    std::uint64_t epoch = 0;
+    /// The current child of memory nodes.
+    std::uint32_t current_child = 0;
+    /// Whether a latch node is latched.
+    bool latched = false;
+    /// The latched status of a latch node.
+    Status::State result = Status::FAILURE;
+  };
+
+  /// Marks the absence of a node index.
+  static constexpr std::uint32_t npos = UINT32_MAX;
+
+  /**
+   * @brief Returns the kind a source node is executed as.
+   *
+   * @param node The source node.
+   * @return Kind The node's kind, Kind::OPAQUE for any other node type.
+   */
+  static Kind kind_of(const BehaviorNode &node);
+
+  /**
+   * @brief Adds a node and its subtree to the flat tree.
+   *
+   * @param node The node to add.
+   * @param indices Indices of already added nodes.
+   * @return std::uint32_t The index of the node.
+   */
+  std::uint32_t
+  add(Layout &layout, const BehaviorPtr &node,
+      std::unordered_map<const BehaviorNode *, std::uint32_t> &indices);
+
+  /**
+   * @brief Ticks a node.
+   *
+   * @param index The index of the node.
+   * @return Status The status of the node.
+   */
+  Status tick(std::uint32_t index);
+
+  /**
+   * @brief Ticks a child node, resetting it first if its parent has been reset
+   * since it was last ticked.
+   *
+   * @param parent The index of the parent node.
+   * @param child The position of the child among the parent's children.
+   * @return Status The status of the child node.
+   */
+  Status tick_child(std::uint32_t parent, std::uint32_t child);
+
+  /**
+   * @brief Ticks a leaf node during a dry run.
+   *
+   * @param index The index of the node.
+   * @return Status The status from the overlay, or the assumed status.
+   */
+  Status tick_dry(std::uint32_t index);
+
+  /**
+   * @brief Resets a node; its subtree is reset lazily.
+   *
+   * @param index The index of the node.
+   */
+  void reset(std::uint32_t index);
+
+  /// The flattened structure.
+  std::shared_ptr<const Layout> layout_;
+  /// Nodes in depth-first order, the root first; points into layout_.
+  const Node *nodes_ = nullptr;
+  /// Child indices of all nodes; points into layout_.
+  const std::uint32_t *children_ = nullptr;
+  /// Mutable state of the nodes.
+  std::vector<NodeState> states_;
+  /// The latest reset epoch.
+  std::uint64_t epoch_ = 0;
+  /// The running dry run, if any.
+  DryRun *dry_run_ = nullptr;
+  /// The clock the time of each tick is sampled from.
+  ClockPtr clock_ = default_clock();
+  /// The context of the tick, installed while the tree runs.
+  TickContext context_{clock_.get()};
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,281 @@
+#pragma once
+
+#include "clock.h"
+#include "nodes/behavior_node.h"
+#include "nodes/status.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <semaphore.h>
+#include <thread>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief Settings of an interrupt subtree.
+ */
+struct InterruptPolicy {
+  /// Interrupts with a higher priority are ticked first when several are
+  /// pending.
+  int priority = 0;
+  /// Services whose latency exceeds the bound are counted as late; zero for no
+  /// bound.
+  Clock::Duration latency_bound = Clock::Duration::zero();
+};
+
+/**
+ * @brief Counters of an interrupt, measured from trigger() to the start of
+ * the subtree's tick.
+ */
+struct InterruptStats {
+  /// The number of times the subtree was ticked.
+  std::uint64_t services = 0;
+  /// The number of triggers that arrived while the interrupt was pending.
+  std::uint64_t coalesced = 0;
+  /// The number of services whose latency exceeded the bound.
+  std::uint64_t late = 0;
+  /// The latency of the latest service.
+  Clock::Duration last_latency = Clock::Duration::zero();
+  /// The largest latency of any service.
+  Clock::Duration max_latency = Clock::Duration::zero();
+};
+
+/**
+ * @brief Wakes the interrupt service of a tree. Shared by the tree and its
+ * interrupts so that triggers stay valid after the tree is gone.
+ */
+class InterruptSignal {
+public:
+  InterruptSignal();
+  InterruptSignal(const InterruptSignal &) = delete;
+  InterruptSignal &operator=(const InterruptSignal &) = delete;
+  ~InterruptSignal();
+
+  /**
+   * @brief Marks an interrupt as pending and wakes the service thread.
+   * Lock-free and async-signal-safe.
+   */
+  void raise();
+
+  /**
+   * @brief Checks whether any interrupt was raised since the latest take().
+   *
+   * @return true if an interrupt is pending.
+   */
+  bool pending() const {
+    return pending_.load(std::memory_order_relaxed) != 0;
+  }
+
+  /**
+   * @brief Clears the pending mark.
+   *
+   * @return true if an interrupt was pending.
+   */
+  bool take();
+
+  /**
+   * @brief Blocks until raise() is called.
+   */
+  void wait();
+
+private:
+  /// The number of raises since the latest take().
+  std::atomic<std::uint32_t> pending_{0};
+  /// Wakes the service thread; sem_post() is async-signal-safe.
+  sem_t wake_;
+};
+
+/**
+ * @brief A subtree which is ticked as soon as possible after it is triggered,
+ * out of the tree's regular ticks.
+ */
+class Interrupt {
+public:
+  /**
+   * @brief Constructs a new Interrupt object. Use
+   * BehaviorTree::add_interrupt() instead.
+   *
+   * @param subtree The subtree ticked when the interrupt is serviced.
+   * @param policy Settings of the interrupt.
+   * @param clock The clock latencies are measured with.
+   * @param signal The signal of the tree's interrupt service.
+   */
+  Interrupt(BehaviorPtr subtree, const InterruptPolicy &policy, ClockPtr clock,
+            std::shared_ptr<InterruptSignal> signal);
+
+  /**
+   * @brief Requests the subtree to be ticked. Triggers which arrive before
+   * the pending service starts are coalesced into it. Lock-free; may be called
+   * from any thread.
+   */
+  void trigger();
+
+  /**
+   * @brief Returns the subtree.
+   *
+   * @return const BehaviorPtr& The subtree.
+   */
+  const BehaviorPtr &subtree() const;
+
+  /**
+   * @brief Returns the settings of the interrupt.
+   *
+   * @return const InterruptPolicy& The settings.
+   */
+  const InterruptPolicy &policy() const;
+
+  /**
+   * @brief Returns the status the subtree returned when it was last ticked.
+   *
+   * @return Status The latest status, Status::Failure before the first tick.
+   */
+  Status last_status() const;
+
+  /**
+   * @brief Returns the counters of the interrupt. May be called from any
+   * thread.
+   *
+   * @return InterruptStats The counters.
+   */
+  InterruptStats stats() const;
+
+private:
+  friend class InterruptService;
+
+  /**
+   * @brief Ticks the subtree if the interrupt is pending.
+   */
+  void service();
+
+  /// Marks triggered_at_ while the interrupt is not pending.
+  static constexpr Clock::Duration::rep IDLE =
+      std::numeric_limits<Clock::Duration::rep>::min();
+
+  /// The subtree ticked when the interrupt is serviced.
+  BehaviorPtr subtree_;
+  /// Settings of the interrupt.
+  InterruptPolicy policy_;
+  /// The clock latencies are measured with.
+  ClockPtr clock_;
+  /// The signal of the tree's interrupt service.
+  std::shared_ptr<InterruptSignal> signal_;
+  /// The time of the first pending trigger, IDLE if there is none.
+  std::atomic<Clock::Duration::rep> triggered_at_{IDLE};
+  /// The status the subtree returned when it was last ticked.
+  std::atomic<Status::State> last_status_{Status::FAILURE};
+  /// The counters, written by the servicing thread only.
+  std::atomic<std::uint64_t> services_{0};
+  std::atomic<std::uint64_t> coalesced_{0};
+  std::atomic<std::uint64_t> late_{0};
+  std::atomic<Clock::Duration::rep> last_latency_{0};
+  std::atomic<Clock::Duration::rep> max_latency_{0};
+};
+
+/**
+ * @brief Services the interrupts of a tree.
+ *
+ * Every tick of the tree and every service hold the tick mutex, so the tree
+ * and its interrupt subtrees are never ticked at the same time. While the tree
+ * is being ticked, pending interrupts are serviced by the ticking thread
+ * itself at the next node boundary, preempting the rest of the traversal.
+ * Otherwise a dedicated service thread ticks them right away; it is started
+ * by the first add(), so a tree without interrupts has no extra thread.
+ */
+class InterruptService {
+public:
+  /**
+   * @brief Constructs a new InterruptService object without interrupts.
+   */
+  InterruptService();
+  InterruptService(const InterruptService &) = delete;
+  InterruptService &operator=(const InterruptService &) = delete;
+
+  /**
+   * @brief Stops the service thread, if it was started.
+   */
+  ~InterruptService();
+
+  /**
+   * @brief Adds an interrupt subtree and starts the service thread if needed.
+   * Waits for a running tick to finish.
+   *
+   * @param subtree The subtree ticked when the interrupt is serviced.
+   * @param policy Settings of the interrupt.
+   * @param clock The clock latencies are measured with.
+   * @return std::shared_ptr<Interrupt> The interrupt, used to trigger it.
+   */
+  std::shared_ptr<Interrupt> add(BehaviorPtr subtree,
+                                 const InterruptPolicy &policy,
+                                 ClockPtr clock);
+
+  /**
+   * @brief Removes an interrupt. Later triggers of it are ignored. Waits for
+   * a running tick to finish.
+   *
+   * @param interrupt The interrupt.
+   */
+  void remove(const std::shared_ptr<Interrupt> &interrupt);
+
+  /**
+   * @brief Checks whether there are no interrupts. Requires the tick mutex.
+   *
+   * @return true if no interrupt was added.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Returns the mutex held while the tree or an interrupt is ticked.
+   *
+   * @return std::mutex& The tick mutex.
+   */
+  std::mutex &tick_mutex();
+
+  /**
+   * @brief Checks whether any interrupt is pending.
+   *
+   * @return true if an interrupt was triggered and not yet serviced.
+   */
+  bool pending() const { return signal_->pending(); }
+
+  /**
+   * @brief Ticks the pending interrupts in the order of their priorities.
+   * Requires the tick mutex.
+   */
+  void service();
+
+  /**
+   * @brief Runs the service thread with a real-time priority (SCHED_FIFO),
+   * starting it if needed.
+   *
+   * @param priority The priority, or 0 for the default scheduling.
+   * @return true if the priority was applied, false if it was not permitted.
+   */
+  bool set_thread_priority(int priority);
+
+private:
+  /**
+   * @brief Starts the service thread unless it runs. Requires the tick mutex.
+   */
+  void start();
+
+  /**
+   * @brief The loop of the service thread.
+   */
+  void serve();
+
+  /// Wakes the service thread.
+  std::shared_ptr<InterruptSignal> signal_;
+  /// Held while the tree or an interrupt is ticked.
+  std::mutex tick_mutex_;
+  /// The interrupts, highest priority first. Guarded by tick_mutex_.
+  std::vector<std::shared_ptr<Interrupt>> interrupts_;
+  /// Whether the service thread must stop.
+  std::atomic<bool> stop_{false};
+  /// The service thread, started by start(). Guarded by tick_mutex_.
+  std::thread thread_;
+};
+
+} // namespace evo::behavior
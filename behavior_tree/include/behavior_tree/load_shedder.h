@@ -0,0 +1,105 @@
+#pragma once
+
+#include "clock.h"
+#include "nodes/behavior_node.h"
+#include "nodes/status.h"
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace evo::behavior {
+
+/**
+ * @brief Settings of load shedding.
+ */
+struct LoadSheddingPolicy {
+  /// The period the tree is ticked with.
+  Clock::Duration period;
+  /// Shedding starts when the tick duration exceeds this fraction of period.
+  double overload_fraction = 0.8;
+  /// Shedding stops when the tick duration falls below this fraction of
+  /// period.
+  double recovery_fraction = 0.5;
+  /// Nodes with a priority below the threshold are shed.
+  int threshold = 0;
+  /// The status shed nodes return instead of being ticked.
+  Status shed_status = Status::Failure;
+  /// Weight of the newest tick duration in the smoothed tick duration.
+  double smoothing = 0.2;
+};
+
+/**
+ * @brief Decides when the tree is overloaded and which nodes are skipped then.
+ *
+ * The shedder tracks a smoothed duration of recent ticks. Once it exceeds
+ * policy.overload_fraction of the period, nodes with a priority below
+ * policy.threshold are skipped until the duration falls below
+ * policy.recovery_fraction of the period.
+ */
+class LoadShedder {
+public:
+  /**
+   * @brief Constructs a new LoadShedder object.
+   *
+   * @param policy Settings of load shedding.
+   */
+  explicit LoadShedder(const LoadSheddingPolicy &policy);
+
+  /**
+   * @brief Returns the settings of load shedding.
+   *
+   * @return const LoadSheddingPolicy& The settings.
+   */
+  const LoadSheddingPolicy &policy() const;
+
+  /**
+   * @brief Checks whether low priority nodes are being shed.
+   *
+   * @return true if the tree is considered overloaded.
+   */
+  bool active() const;
+
+  /**
+   * @brief Returns the smoothed tick duration as a fraction of the period.
+   *
+   * @return double The load of the tree.
+   */
+  double load() const;
+
+  /**
+   * @brief Accounts the duration of a finished tick.
+   *
+   * @param duration The time the tick took.
+   */
+  void record_tick(Clock::Duration duration);
+
+  /**
+   * @brief Decides whether a node is shed and counts it if so.
+   *
+   * @param node The node about to be ticked.
+   * @return std::optional<Status> The status the shed node returns, or nothing
+   * if the node must be ticked.
+   */
+  std::optional<Status> shed(const BehaviorNode &node);
+
+  /**
+   * @brief Returns how many times nodes were shed, per node priority.
+   *
+   * @return const std::map<int, std::uint64_t>& Shed counts by priority.
+   */
+  const std::map<int, std::uint64_t> &shed_counts() const;
+
+private:
+  /// Settings of load shedding.
+  LoadSheddingPolicy policy_;
+  /// Whether low priority nodes are being shed.
+  bool active_ = false;
+  /// The smoothed tick duration as a fraction of the period.
+  double load_ = 0.0;
+  /// Whether any tick has been recorded.
+  bool recorded_ = false;
+  /// Shed counts by node priority.
+  std::map<int, std::uint64_t> shed_counts_;
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,402 @@
+#pragma once
+
+#include "clock.h"
+#include "node_index.h"
+#include "nodes/behavior_node.h"
+#include "tick_observer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief A block of counters sharded per thread.
+ *
+ * Every thread increments the counters of its own shard, which lies on
+ * separate cache lines, with a relaxed atomic addition; reading a counter sums
+ * it over all shards.
+ */
+class ShardedCounters {
+public:
+  /// The number of shards, threads beyond it share shards.
+  static constexpr std::size_t shards = 16;
+
+  /**
+   * @brief Constructs a new ShardedCounters object with all counters zero.
+   *
+   * @param size The number of counters.
+   */
+  explicit ShardedCounters(std::size_t size);
+
+  /**
+   * @brief Adds to a counter.
+   *
+   * @param index The index of the counter.
+   * @param value The value to add.
+   */
+  void add(std::size_t index, std::uint64_t value = 1) {
+    counter(shard() * stride_ + index)
+        .fetch_add(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Adds to a counter whose writers never run at the same time, e.g.
+   * the ticks of one tree. The first shard is updated with a relaxed load and
+   * store instead of an atomic read-modify-write.
+   *
+   * @param index The index of the counter.
+   * @param value The value to add.
+   */
+  void add_exclusive(std::size_t index, std::uint64_t value = 1) {
+    auto &target = counter(index);
+    target.store(target.load(std::memory_order_relaxed) + value,
+                 std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns the sum of a counter over all shards.
+   *
+   * @param index The index of the counter.
+   * @return std::uint64_t The counter's value.
+   */
+  std::uint64_t value(std::size_t index) const;
+
+  /**
+   * @brief Returns the number of counters.
+   *
+   * @return std::size_t The number of counters.
+   */
+  std::size_t size() const;
+
+private:
+  /// One cache line of counters.
+  struct alignas(64) Line {
+    std::atomic<std::uint64_t> counters[8];
+  };
+
+  /// Returns the shard of the calling thread.
+  static std::size_t shard() {
+    thread_local const std::size_t shard = assign_shard();
+    return shard;
+  }
+
+  /// Assigns shards to threads in turn.
+  static std::size_t assign_shard();
+
+  /// Returns a counter by its position in lines_.
+  std::atomic<std::uint64_t> &counter(std::size_t position) const {
+    return lines_[position / 8].counters[position % 8];
+  }
+
+  /// The number of counters.
+  std::size_t size_;
+  /// The distance between the shards of a counter, a whole number of cache
+  /// lines.
+  std::size_t stride_;
+  /// The counters of all shards, shard by shard.
+  std::unique_ptr<Line[]> lines_;
+};
+
+/// Label names and values of a sample.
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief Receives metrics when a registry is scraped.
+ *
+ * Each family is announced once, before its samples.
+ */
+class MetricsWriter {
+public:
+  /**
+   * @brief Virtual destructor for safe polymorphic use.
+   */
+  virtual ~MetricsWriter() = default;
+
+  /**
+   * @brief Starts a metric family.
+   *
+   * @param name The family's name.
+   * @param type The family's type: "counter", "gauge" or "histogram".
+   * @param help A description of the family.
+   */
+  virtual void family(const std::string &name, const std::string &type,
+                      const std::string &help) = 0;
+
+  /**
+   * @brief Writes a sample of the current family.
+   *
+   * @param name The sample's name, e.g. with a _bucket suffix for histograms.
+   * @param labels The sample's labels.
+   * @param value The sample's value.
+   */
+  virtual void sample(const std::string &name, const MetricLabels &labels,
+                      double value) = 0;
+};
+
+/**
+ * @brief Writes metrics in the Prometheus text exposition format.
+ */
+class PrometheusWriter : public MetricsWriter {
+public:
+  /**
+   * @brief Constructs a new PrometheusWriter object.
+   *
+   * @param out The stream to write to.
+   */
+  explicit PrometheusWriter(std::ostream &out);
+
+  void family(const std::string &name, const std::string &type,
+              const std::string &help) override;
+  void sample(const std::string &name, const MetricLabels &labels,
+              double value) override;
+
+private:
+  /// The stream to write to.
+  std::ostream &out_;
+};
+
+/**
+ * @brief A source of metrics, e.g. the metrics of one tree.
+ */
+class MetricsSource {
+public:
+  /**
+   * @brief Virtual destructor for safe polymorphic use.
+   */
+  virtual ~MetricsSource() = default;
+
+  /**
+   * @brief Writes the current values of the source's metrics. May be called
+   * from any thread.
+   *
+   * @param writer The writer to pass the metrics to.
+   */
+  virtual void collect(MetricsWriter &writer) const = 0;
+};
+
+/**
+ * @brief A set of metrics sources which are collected together.
+ *
+ * Families written by several sources are merged, so that each family is
+ * announced once.
+ */
+class MetricsRegistry {
+public:
+  /**
+   * @brief Returns the registry which contains the library's metrics and the
+   * metrics of trees unless they are given another registry.
+   *
+   * @return MetricsRegistry& The global registry.
+   */
+  static MetricsRegistry &global();
+
+  /**
+   * @brief Adds a source, which is dropped automatically once it expires.
+   *
+   * @param source The source to add.
+   */
+  void add(const std::shared_ptr<const MetricsSource> &source);
+
+  /**
+   * @brief Removes a source.
+   *
+   * @param source The source to remove.
+   */
+  void remove(const MetricsSource *source);
+
+  /**
+   * @brief Collects the metrics of all sources.
+   *
+   * @param writer The writer to pass the metrics to.
+   */
+  void write(MetricsWriter &writer) const;
+
+  /**
+   * @brief Collects the metrics of all sources in the Prometheus text format.
+   *
+   * @return std::string The metrics.
+   */
+  std::string scrape() const;
+
+private:
+  /// Protects sources_.
+  mutable std::mutex mutex_;
+  /// The sources.
+  mutable std::vector<std::weak_ptr<const MetricsSource>> sources_;
+};
+
+/**
+ * @brief Counters of events inside the library's nodes, which are part of
+ * the global registry.
+ */
+class LibraryMetrics : public MetricsSource {
+public:
+  /// The counted events.
+  enum Counter {
+    /// Exceptions caught by Action nodes.
+    ACTION_EXCEPTIONS,
+    /// Exceptions caught by Condition nodes.
+    CONDITION_EXCEPTIONS,
+    /// Memory nodes which completed and start over with their first child.
+    MEMORY_RESTARTS,
+    COUNTER_COUNT
+  };
+
+  LibraryMetrics();
+
+  /**
+   * @brief Counts an event.
+   *
+   * @param counter The event.
+   */
+  void add(Counter counter) { counters_.add(counter); }
+
+  /**
+   * @brief Returns the number of events.
+   *
+   * @param counter The event.
+   * @return std::uint64_t The number of events so far.
+   */
+  std::uint64_t value(Counter counter) const;
+
+  void collect(MetricsWriter &writer) const override;
+
+private:
+  /// The counters, indexed by Counter.
+  ShardedCounters counters_;
+};
+
+/**
+ * @brief Returns the library's counters.
+ *
+ * @return LibraryMetrics& The library's counters.
+ */
+LibraryMetrics &library_metrics();
+
+/**
+ * @brief A tick observer which counts the ticks of a tree, their durations and
+ * the visits and statuses of each node. BehaviorTree installs one when its
+ * metrics are enabled.
+ *
+ * The ticks of a tree never run at the same time, so the ticking thread counts
+ * with relaxed atomic loads and stores; scrapes read the counters from any
+ * thread.
+ */
+class TreeMetrics : public TickObserver, public MetricsSource {
+public:
+  /**
+   * @brief Constructs a new TreeMetrics object.
+   *
+   * @param tree The name of the tree, used as the tree label.
+   * @param clock The clock measuring tick durations.
+   * @param buckets The upper bounds of the tick duration histogram's buckets in
+   * seconds, in increasing order.
+   */
+  TreeMetrics(std::string tree, ClockPtr clock,
+              std::vector<double> buckets = default_buckets());
+
+  /**
+   * @brief Returns the default upper bounds of the tick duration buckets, from
+   * one microsecond to one second.
+   *
+   * @return std::vector<double> The bounds in seconds.
+   */
+  static std::vector<double> default_buckets();
+
+  /**
+   * @brief Numbers the nodes of a new tree and resets their counters. Must not
+   * be called during a tick.
+   *
+   * @param root The root node of the tree.
+   */
+  void set_root(const BehaviorPtr &root);
+
+  /**
+   * @brief Counts the nodes of a tree numbered by an index shared with other
+   * observers, and resets their counters. Must not be called during a tick.
+   *
+   * @param index The index of the tree's nodes.
+   */
+  void set_index(std::shared_ptr<const NodeIndex> index);
+
+  /**
+   * @brief Sets the clock measuring tick durations.
+   *
+   * @param clock The clock.
+   */
+  void set_clock(ClockPtr clock);
+
+  /**
+   * @brief Returns the number of completed ticks.
+   *
+   * @return std::uint64_t The number of ticks.
+   */
+  std::uint64_t ticks() const;
+
+  /**
+   * @brief Returns the number of times a node was ticked.
+   *
+   * @param node The node.
+   * @return std::uint64_t The number of visits, 0 for unknown nodes.
+   */
+  std::uint64_t visits(const BehaviorNode &node) const;
+
+  /**
+   * @brief Returns the number of times a node returned a status.
+   *
+   * @param node The node.
+   * @param status The status.
+   * @return std::uint64_t The number of times, 0 for unknown nodes.
+   */
+  std::uint64_t count(const BehaviorNode &node, Status status) const;
+
+  void on_enter(const BehaviorNode &node) override;
+  void on_exit(const BehaviorNode &node, Status status) override;
+  void collect(MetricsWriter &writer) const override;
+
+private:
+  /// The counters of a node: visits, then one per status.
+  static constexpr std::size_t node_counters = 5;
+
+  /// The labels of a node of the tree, as of set_index().
+  struct NodeInfo {
+    /// The node's type.
+    std::string type;
+    /// The node's description.
+    std::string description;
+  };
+
+  /// Returns the index of a node's first counter.
+  std::size_t node_offset(std::uint32_t id) const;
+
+  /// The name of the tree.
+  std::string tree_;
+  /// The clock measuring tick durations.
+  ClockPtr clock_;
+  /// The upper bounds of the duration buckets in seconds.
+  std::vector<double> buckets_;
+  /// Protects the index, nodes_ and counters_ against set_index() during
+  /// scrapes.
+  mutable std::mutex mutex_;
+  /// Ids of the nodes. Nodes freed since set_index() are no longer counted,
+  /// even if a new node takes their address.
+  std::shared_ptr<const NodeIndex> index_;
+  /// The labels of the nodes by id.
+  std::vector<NodeInfo> nodes_;
+  /// Ticks, the duration sum in nanoseconds, the buckets including +Inf, then
+  /// the counters of each node.
+  std::unique_ptr<ShardedCounters> counters_;
+  /// The nesting depth of the current tick.
+  std::size_t depth_ = 0;
+  /// The start of the current tick.
+  Clock::TimePoint start_;
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "nodes/behavior_node.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief Numbers the nodes of a tree in depth-first order from the root,
+ * shared nodes once, so that observers keep per-node state in arrays.
+ *
+ * Building an index stamps every node with its id, so find() only compares
+ * the node's stamp with the index's generation. Nodes stamped by a newer index
+ * over the same nodes, e.g. of another tree sharing them, are looked up by
+ * address instead, skipping nodes freed since the index was built. Share one
+ * index among the observers of a tree, see BehaviorTree::node_index(), to
+ * keep lookups on the fast path.
+ *
+ * Build indices while the nodes are not being ticked.
+ */
+class NodeIndex {
+public:
+  /**
+   * @brief Numbers the nodes of a tree.
+   *
+   * @param root The root node of the tree, or nullptr for an empty index.
+   */
+  explicit NodeIndex(const BehaviorPtr &root);
+
+  NodeIndex(const NodeIndex &) = delete;
+  NodeIndex &operator=(const NodeIndex &) = delete;
+
+  /**
+   * @brief Returns the number of nodes.
+   *
+   * @return std::size_t The number of nodes.
+   */
+  std::size_t size() const { return nodes_.size(); }
+
+  /**
+   * @brief Identifies the index; no two indices of a process share it.
+   *
+   * @return std::uint64_t The generation, never 0.
+   */
+  std::uint64_t generation() const { return generation_; }
+
+  /**
+   * @brief Returns the id of a node.
+   *
+   * @param node The node.
+   * @return std::optional<std::uint32_t> The id, or nothing if the node was
+   * not part of the tree.
+   */
+  std::optional<std::uint32_t> find(const BehaviorNode &node) const {
+    if (node.index_.generation == generation_) {
+      return node.index_.id;
+    }
+    return find_by_address(node);
+  }
+
+  /**
+   * @brief Returns the node with the given id.
+   *
+   * @param id The id of the node.
+   * @return std::shared_ptr<const BehaviorNode> The node, or nullptr if it
+   * was freed or the id is unknown.
+   */
+  std::shared_ptr<const BehaviorNode> node(std::uint32_t id) const;
+
+private:
+  /// Looks up a node whose stamp was replaced by another index.
+  std::optional<std::uint32_t> find_by_address(const BehaviorNode &node) const;
+
+  /// The generation stamped on the nodes.
+  std::uint64_t generation_;
+  /// The nodes by id.
+  std::vector<std::weak_ptr<const BehaviorNode>> nodes_;
+  /// Ids of the nodes by address.
+  std::unordered_map<const BehaviorNode *, std::uint32_t> ids_;
+};
+
+} // namespace evo::behavior
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../tick_context.h"
 #include "behavior_node.h"
 #include "status.h" // Include the Status class header
 #include <exception>
@@ -24,6 +25,17 @@ public:
    */
   Action(std::function<void()> behavior, std::string const &description);
 
+  /**
+   * @brief Constructs a new Action object whose behavior receives the tick's
+   * context.
+   *
+   * @param behavior A function to be executed by this node, taking the
+   * context of the tick.
+   * @param description A text description for behavior tree viewer.
+   */
+  Action(std::function<void(TickContext &)> behavior,
+         std::string const &description);
+
   /**
    * @brief Default constructor, deleted to enforce providing behavior and
    * description.
@@ -51,6 +63,9 @@ public:
 private:
   /// The node's logic to be executed, does not return a value.
   std::function<void()> behavior_;
+  /// The node's logic taking the tick's context, used instead of behavior_
+  /// if set.
+  std::function<void(TickContext &)> contextual_;
 };
 
 } // namespace evo::behavior
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "status.h" // Include the Status class header
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -20,6 +23,9 @@ class BehaviorNode {
 public:
   using Children = std::vector<BehaviorPtr>;
 
+  /// Priority of nodes which are never shed under load.
+  static constexpr int max_priority = std::numeric_limits<int>::max();
+
   /**
    * @brief Constructs a new Behavior Node object with detailed specifications.
    *
@@ -82,23 +88,100 @@ public:
 
   const Children &children() const;
 
+  /**
+   * @brief Returns the node's priority. Under overload, load shedding skips
+   * nodes, together with their subtrees, whose priority is below a threshold.
+   *
+   * @return int The node's priority, max_priority unless set.
+   */
+  int priority() const;
+
+  /**
+   * @brief Sets the node's priority.
+   *
+   * @param priority The priority of the node and its subtree.
+   */
+  void set_priority(int priority);
+
+  /**
+   * @brief Replaces a child node, e.g. with an optimized equivalent. Must not
+   * be called while the tree is being ticked.
+   *
+   * @param index The position of the child to replace.
+   * @param child The new child node.
+   * @throws std::out_of_range If the node has no child at the index.
+   * @throws std::invalid_argument If the new child is null.
+   */
+  void replace_child(std::size_t index, BehaviorPtr child);
+
   /**
    * @brief Resets node state to its initial condition, if applicable.
    *
    * This function resets the state of the node and its children, which is
    * particularly useful in behavior trees where nodes may be executed multiple
    * times with stateful behavior.
+   *
+   * The reset is lazy: the base implementation only starts a new reset epoch
+   * for this node, and every descendant resets itself the next time it is
+   * ticked through tick_child(). Overrides should call BehaviorNode::reset()
+   * and reinitialize only the node's own state.
    */
   virtual void reset();
 
+  /**
+   * @brief Allocates the storage the node needs while ticking, so that later
+   * ticks do not allocate. BehaviorTree::set_real_time() calls it for every
+   * node, parents before their children; the default does nothing.
+   */
+  virtual void preallocate();
+
+protected:
+  /**
+   * @brief Ticks a child node, resetting it first if this node has been reset
+   * since the child was last ticked.
+   *
+   * Control nodes must tick their children through this function for lazy
+   * resets to reach the whole subtree. If the tick's budget is spent, the
+   * child is not ticked and Status::Incomplete is returned; the caller must
+   * then return Status::Incomplete too and resume from the same child on its
+   * next tick. If the tree is overloaded and the child's priority is low, the
+   * child is shed: it is not ticked and the load shedding status is returned.
+   *
+   * @param child The child node to tick.
+   * @return Status The status returned by the child, or Status::Incomplete.
+   */
+  Status tick_child(const BehaviorPtr &child);
+
 private:
+  friend class NodeIndex;
+
+  /// The id a NodeIndex gave the node. Copies of the node start without one.
+  struct IndexSlot {
+    IndexSlot() = default;
+    IndexSlot(const IndexSlot &) {}
+    IndexSlot &operator=(const IndexSlot &) { return *this; }
+
+    /// The generation of the index, 0 if none.
+    std::uint64_t generation = 0;
+    /// The node's id in that index.
+    std::uint32_t id = 0;
+  };
+
   /// The node's type.
   std::string type_;
   /// The node's description.
   std::string description_;
+  /// The epoch of the latest reset which reached this node.
+  std::uint64_t epoch_ = 0;
+  /// The node's priority for load shedding.
+  int priority_ = max_priority;
+  /// The id given by the latest NodeIndex built over the node.
+  IndexSlot index_;
 protected:
   /// The node's child nodes.
   Children children_;
+  /// Position to resume from after an incomplete tick, cleared by reset().
+  std::size_t resume_child_ = 0;
 };
 
 } // namespace evo::behavior
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "behavior_node.h"
+#include "status.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief Represents a subtree made only of Condition, Not, Sequence and
+ * Fallback nodes, compiled into a boolean formula over its conditions.
+ *
+ * The node samples each distinct condition once per tick into a bit vector
+ * and looks the result up in a truth table, or, for many conditions, in a
+ * reduced ordered binary decision diagram. Unlike the subtree it replaces,
+ * the node always samples all the conditions, so it must only be used for
+ * conditions without side effects. If a condition returns Status::Running,
+ * the subtree's structure is evaluated over the sampled statuses in the
+ * subtree's order, so the node returns what the subtree would, e.g. Failure
+ * for a Sequence whose first condition fails and second one is running.
+ *
+ * The conditions are the node's children, so lazy resets, budgeted ticks and
+ * load shedding apply to them as usual.
+ */
+class BooleanFormula : public BehaviorNode {
+public:
+  /// The largest number of conditions evaluated with a truth table.
+  static constexpr std::size_t max_table_conditions = 10;
+
+  /**
+   * @brief Compiles a subtree into a boolean formula.
+   *
+   * @param subtree The root of the subtree.
+   * @throws std::invalid_argument If the subtree is not pure, see is_pure().
+   */
+  explicit BooleanFormula(const BehaviorPtr &subtree);
+
+  /**
+   * @brief Checks whether a subtree is made only of Condition, Not, Sequence
+   * and Fallback nodes. Derived classes of these nodes are not pure because
+   * they may override operator().
+   *
+   * @param subtree The root of the subtree.
+   * @return true If the subtree can be compiled into a boolean formula.
+   */
+  static bool is_pure(const BehaviorNode &subtree);
+
+  /**
+   * @brief Samples the conditions and evaluates the formula.
+   *
+   * @return Status::Success, Status::Failure or Status::Running as the
+   * subtree would return for the sampled conditions.
+   */
+  Status operator()() override;
+
+  /**
+   * @brief Tells whether the formula is evaluated with a truth table rather
+   * than a decision diagram.
+   *
+   * @return true If the formula has at most max_table_conditions conditions.
+   */
+  bool uses_table() const;
+
+  /**
+   * @brief Returns the number of inner nodes of the decision diagram.
+   *
+   * @return std::size_t The size of the reduced diagram.
+   */
+  std::size_t diagram_size() const;
+
+private:
+  /// An inner node of the decision diagram, references 0 and 1 are the
+  /// constant false and true.
+  struct DiagramNode {
+    /// Index of the condition the node tests.
+    std::uint32_t condition;
+    /// The node followed if the condition fails.
+    std::uint32_t low;
+    /// The node followed if the condition succeeds.
+    std::uint32_t high;
+  };
+
+  /// A node of the compiled subtree, kept in depth-first order to evaluate
+  /// the subtree when a condition is running.
+  struct Term {
+    /// The kinds of nodes in a pure subtree.
+    enum Kind : std::uint8_t { CONDITION, NOT, SEQUENCE, FALLBACK };
+
+    /// The kind of the node.
+    Kind kind;
+    /// Index of the condition, for condition terms.
+    std::uint32_t condition;
+    /// Index of the term following the node's subtree.
+    std::uint32_t end;
+  };
+
+  class Builder;
+
+  /// Evaluates the decision diagram for the sampled conditions.
+  bool evaluate_diagram() const;
+
+  /// Evaluates the subtree of a term in order, for running conditions.
+  Status::State evaluate_terms(std::uint32_t term) const;
+
+  /// Tells whether a bit of a sampled condition vector is set.
+  static bool test(const std::vector<std::uint64_t> &bits, std::size_t index);
+
+  /// Decision diagram nodes, the first two are the constants.
+  std::vector<DiagramNode> diagram_;
+  /// The root of the decision diagram.
+  std::uint32_t root_ = 0;
+  /// Truth table indexed by the sampled conditions, empty if not used.
+  std::vector<std::uint64_t> table_;
+  /// The compiled subtree in depth-first order.
+  std::vector<Term> terms_;
+  /// Results of the conditions sampled so far in the current tick.
+  std::vector<std::uint64_t> sampled_;
+  /// Conditions which returned Status::Running in the current tick.
+  std::vector<std::uint64_t> running_;
+};
+
+/**
+ * @brief Replaces the pure subtrees of a tree with BooleanFormula nodes.
+ *
+ * Only maximal pure subtrees with at least min_conditions distinct conditions
+ * are replaced. Nodes shared between parents are compiled once.
+ *
+ * @param root The root of the tree.
+ * @param min_conditions The smallest number of conditions worth compiling.
+ * @return BehaviorPtr The new root, which differs from root only if the whole
+ * tree is pure.
+ */
+BehaviorPtr compile_conditions(const BehaviorPtr &root,
+                               std::size_t min_conditions = 2);
+
+} // namespace evo::behavior
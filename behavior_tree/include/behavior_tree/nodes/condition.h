@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../tick_context.h"
 #include "behavior_node.h"
 #include "status.h" // Ensure the Status class is included correctly
 #include <functional>
@@ -13,6 +14,11 @@ namespace evo::behavior {
  *
  * This class embodies a condition within a behavior tree, typically used to
  * decide which path the tree should take.
+ *
+ * A prefetchable condition has no side effects and may be evaluated before the
+ * tick, concurrently with other conditions, see BehaviorTree::set_prefetching.
+ * While a prefetched result is held, ticks return it instead of evaluating
+ * the condition again.
  */
 class Condition : public BehaviorNode {
 public:
@@ -25,6 +31,17 @@ public:
    */
   Condition(std::function<Status()> condition, const std::string &description);
 
+  /**
+   * @brief Constructs a new Condition object whose logic receives the tick's
+   * context.
+   *
+   * @param condition A function to be executed by this node, taking the
+   * context of the tick and returning a Status.
+   * @param description A text description for behavior tree viewer.
+   */
+  Condition(std::function<Status(TickContext &)> condition,
+            const std::string &description);
+
   /**
    * @brief Executes the node's logic.
    *
@@ -32,9 +49,47 @@ public:
    */
   Status operator()() override;
 
+  /**
+   * @brief Tells whether the condition may be evaluated ahead of the tick.
+   *
+   * @return true If the condition has no side effects.
+   */
+  bool prefetchable() const;
+
+  /**
+   * @brief Marks the condition as free of side effects, or not.
+   *
+   * @param prefetchable Whether the condition may be evaluated ahead of the
+   * tick.
+   */
+  void set_prefetchable(bool prefetchable);
+
+  /**
+   * @brief Evaluates the condition and holds the result for the next ticks.
+   * Different conditions may be prefetched concurrently.
+   */
+  void prefetch();
+
+  /**
+   * @brief Drops the prefetched result, so ticks evaluate the condition again.
+   */
+  void discard_prefetched();
+
 private:
+  /// Evaluates the condition, turning exceptions into Status::Failure.
+  Status evaluate() const;
+
   /// The node's logic to be executed, adjusted to return a Status.
   std::function<Status()> condition_;
+  /// The node's logic taking the tick's context, used instead of condition_
+  /// if set.
+  std::function<Status(TickContext &)> contextual_;
+  /// Whether the condition may be evaluated ahead of the tick.
+  bool prefetchable_ = false;
+  /// Whether prefetched_ holds a result.
+  bool has_prefetched_ = false;
+  /// The result of the latest prefetch.
+  Status prefetched_ = Status::Failure;
 };
 
 } // namespace evo::behavior
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../../clock.h"
+#include "../behavior_node.h"
+#include "../status.h"
+#include <memory>
+
+namespace evo::behavior {
+
+/**
+ * @brief A decorator node that reuses the terminal status of its child for a
+ * given time.
+ *
+ * Status::Success and Status::Failure are cached until they expire, and the
+ * child is not ticked meanwhile. Status::Running is never cached: the child is
+ * ticked again on the next call.
+ */
+class Cached : public BehaviorNode {
+public:
+  /**
+   * @brief Constructs a new Cached decorator node.
+   *
+   * @param child The child node whose result is cached.
+   * @param ttl The time a terminal status stays valid.
+   * @param clock The clock used to expire the cached status.
+   */
+  Cached(BehaviorPtr child, Clock::Duration ttl,
+         ClockPtr clock = default_clock());
+
+  /**
+   * @brief Returns the cached status if it is still valid, otherwise ticks the
+   * child.
+   *
+   * @return Status The cached status or the status returned by the child.
+   */
+  Status operator()() override;
+
+  /**
+   * @brief Drops the cached status.
+   */
+  void reset() override;
+
+private:
+  /// The time a terminal status stays valid.
+  Clock::Duration ttl_;
+  /// The clock used to expire the cached status.
+  ClockPtr clock_;
+  /// Whether a status is cached.
+  bool cached_ = false;
+  /// The time the cached status expires.
+  Clock::TimePoint expiry_;
+  /// The cached status.
+  Status result_ = Status::Failure;
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../../clock.h"
+#include "../behavior_node.h"
+#include "../status.h"
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <string>
+
+namespace evo::behavior {
+
+/**
+ * @brief A decorator node that stands in for a subtree which is only built
+ * when it is needed.
+ *
+ * The builder runs when the node is ticked for the first time, or ahead of
+ * that in a background thread after prewarm(). The built subtree becomes the
+ * node's only child. Subtrees which were not ticked for the idle timeout may
+ * be freed by release_idle() and are built again when ticked next.
+ */
+class Lazy : public BehaviorNode {
+public:
+  /// Builds the subtree.
+  using Builder = std::function<BehaviorPtr()>;
+
+  /**
+   * @brief Constructs a new Lazy decorator node.
+   *
+   * @param builder Builds the subtree.
+   * @param description A text description for behavior tree viewer.
+   * @param idle_timeout The time without ticks after which the subtree may be
+   * freed; zero to keep it forever.
+   * @param clock The clock used to measure the idle time.
+   * @throws std::invalid_argument If the builder is empty.
+   */
+  Lazy(Builder builder, const std::string &description,
+       Clock::Duration idle_timeout = Clock::Duration::zero(),
+       ClockPtr clock = default_clock());
+
+  /**
+   * @brief Waits for a background build which is still running.
+   */
+  ~Lazy() override;
+
+  /**
+   * @brief Ticks the subtree, building it first if needed.
+   *
+   * @return Status The status returned by the subtree.
+   * @throws std::runtime_error If the builder returns no subtree.
+   */
+  Status operator()() override;
+
+  /**
+   * @brief Builds the subtree now, waiting for a background build if one is
+   * running.
+   */
+  void preallocate() override;
+
+  /**
+   * @brief Starts building the subtree in a background thread, unless it is
+   * built or being built. The builder must not access the tree. Must not be
+   * called during a tick.
+   */
+  void prewarm();
+
+  /**
+   * @brief Checks whether the subtree is built.
+   *
+   * @return true if the subtree is built.
+   */
+  bool built() const;
+
+  /**
+   * @brief Frees the subtree. Must not be called during a tick.
+   */
+  void release();
+
+  /**
+   * @brief Frees the subtrees of the lazy nodes in a tree which have not been
+   * ticked for their idle timeout. Must not be called during a tick.
+   *
+   * @param root The root node of the tree.
+   * @return std::size_t The number of freed subtrees.
+   */
+  static std::size_t release_idle(const BehaviorPtr &root);
+
+private:
+  /// Builds the subtree.
+  Builder builder_;
+  /// The time without ticks after which the subtree may be freed.
+  Clock::Duration idle_timeout_;
+  /// The clock used to measure the idle time.
+  ClockPtr clock_;
+  /// The time of the latest tick.
+  Clock::TimePoint last_tick_;
+  /// The idle deadline last reported to the clock.
+  Clock::TimePoint reported_deadline_;
+  /// The subtree being built in the background, if any.
+  std::future<BehaviorPtr> pending_;
+};
+
+} // namespace evo::behavior
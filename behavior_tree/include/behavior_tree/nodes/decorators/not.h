@@ -13,6 +13,7 @@ namespace evo::behavior {
  * - SUCCESS becomes FAILURE
  * - FAILURE becomes SUCCESS
  * - RUNNING remains RUNNING
+ * - INCOMPLETE remains INCOMPLETE
  */
 class Not : public BehaviorNode {
 public:
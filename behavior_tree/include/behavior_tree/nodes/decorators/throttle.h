@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../../clock.h"
+#include "../behavior_node.h"
+#include "../status.h"
+#include <memory>
+
+namespace evo::behavior {
+
+/**
+ * @brief A decorator node that ticks its child at most once per period.
+ *
+ * Between the child's ticks the node returns the child's last status. This is
+ * useful for expensive subtrees whose inputs change slower than the tree is
+ * ticked.
+ */
+class Throttle : public BehaviorNode {
+public:
+  /**
+   * @brief Constructs a new Throttle decorator node.
+   *
+   * @param child The child node to be rate limited.
+   * @param period The minimal time between two ticks of the child.
+   * @param clock The clock used to measure the period.
+   */
+  Throttle(BehaviorPtr child, Clock::Duration period,
+           ClockPtr clock = default_clock());
+
+  /**
+   * @brief Ticks the child if the period has passed since its last tick.
+   *
+   * @return Status The status returned by the child on its last tick.
+   */
+  Status operator()() override;
+
+  /**
+   * @brief Resets the node so that the child is ticked on the next call.
+   */
+  void reset() override;
+
+private:
+  /// The minimal time between two ticks of the child.
+  Clock::Duration period_;
+  /// The clock used to measure the period.
+  ClockPtr clock_;
+  /// Whether the child has been ticked since the last reset.
+  bool ticked_ = false;
+  /// The time of the child's last tick.
+  Clock::TimePoint last_tick_;
+  /// The status returned by the child on its last tick.
+  Status last_result_ = Status::Failure;
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "behavior_node.h"
+#include "status.h"
+#include <atomic>
+#include <string>
+
+namespace evo::behavior {
+
+/**
+ * @brief Base class for control nodes whose children are added, removed and
+ * replaced at runtime, e.g. to feed jobs to a tree without rebuilding it.
+ *
+ * @details Any thread may submit changes at any time; they are pushed onto a
+ * lock-free list and applied in submission order by the ticking thread when
+ * the node starts a new traversal of its children, never in the middle of
+ * one. Removed children are destroyed once no one else holds them; added
+ * children start from their initial state. Optionally, children which
+ * finished with the pass status are removed automatically, so the node
+ * consumes its children like a queue of jobs.
+ */
+class DynamicComposite : public BehaviorNode {
+public:
+  /**
+   * @brief Constructs a new DynamicComposite object.
+   *
+   * @param type The type of the node.
+   * @param description A text description for behavior tree viewer.
+   * @param children The initial child nodes.
+   */
+  DynamicComposite(const std::string &type, const std::string &description,
+                   const Children &children);
+
+  DynamicComposite(const DynamicComposite &) = delete;
+  DynamicComposite &operator=(const DynamicComposite &) = delete;
+
+  /**
+   * @brief Discards the changes which were not applied.
+   */
+  ~DynamicComposite() override;
+
+  /**
+   * @brief Appends a child. May be called from any thread.
+   *
+   * @param child The new child node.
+   * @throws std::invalid_argument If the child is null.
+   */
+  void append(BehaviorPtr child);
+
+  /**
+   * @brief Removes a child, if it is still there when the change is applied.
+   * May be called from any thread.
+   *
+   * @param child The child node to remove.
+   */
+  void remove(BehaviorPtr child);
+
+  /**
+   * @brief Replaces a child, if it is still there when the change is applied.
+   * May be called from any thread.
+   *
+   * @param child The child node to replace.
+   * @param replacement The new child node.
+   * @throws std::invalid_argument If the replacement is null.
+   */
+  void replace(BehaviorPtr child, BehaviorPtr replacement);
+
+  /**
+   * @brief Removes all children. May be called from any thread.
+   */
+  void clear();
+
+  /**
+   * @brief Removes children automatically once they return the status which
+   * lets the evaluation continue.
+   *
+   * @param consume Whether finished children are removed.
+   */
+  void consume_finished(bool consume = true);
+
+  /**
+   * @brief Checks whether finished children are removed automatically.
+   *
+   * @return true if finished children are removed.
+   */
+  bool consumes_finished() const;
+
+protected:
+  /**
+   * @brief Applies the pending changes unless a traversal is in progress,
+   * then ticks the children until one of them returns a status other than
+   * pass_status.
+   *
+   * @param pass_status The status which lets the evaluation continue.
+   * @return Status The first status other than pass_status, or pass_status if
+   * all children returned it.
+   */
+  Status tick_children(const Status &pass_status);
+
+private:
+  /// A submitted change of the children.
+  struct Change {
+    enum Kind { APPEND, REMOVE, REPLACE, CLEAR };
+
+    Kind kind;
+    BehaviorPtr child;
+    BehaviorPtr replacement;
+    /// The change submitted before this one.
+    Change *next = nullptr;
+  };
+
+  /// Pushes a change onto the pending list.
+  void submit(Change *change);
+
+  /// Applies the pending changes in submission order.
+  void apply_changes();
+
+  /// The latest submitted change which has not been applied.
+  std::atomic<Change *> pending_{nullptr};
+  /// Whether finished children are removed.
+  bool consume_ = false;
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "dynamic_composite.h"
+#include "status.h"
+#include <string>
+
+namespace evo::behavior {
+
+/**
+ * @brief Represents a fallback node whose children may change at runtime.
+ *
+ * The node behaves like Fallback over its current children; see
+ * DynamicComposite for how children are submitted. When finished children are
+ * consumed, each child is removed once it fails, so alternatives which did
+ * not work out are not tried again.
+ */
+class DynamicFallback : public DynamicComposite {
+public:
+  /**
+   * @brief Constructs a new DynamicFallback object.
+   *
+   * @param description A text description for behavior tree viewer.
+   * @param children The initial child nodes.
+   */
+  DynamicFallback(const std::string &description, const Children &children);
+
+  /**
+   * @brief Executes the node's logic.
+   *
+   * @return Status::Failure if all child nodes return Status::Failure.
+   * @return Status::Success or Status::Running as returned by the first child
+   * node which does not fail.
+   */
+  Status operator()() override;
+};
+
+} // namespace evo::behavior
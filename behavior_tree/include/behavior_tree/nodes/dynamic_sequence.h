@@ -0,0 +1,37 @@
+#pragma once
+
+#include "dynamic_composite.h"
+#include "status.h"
+#include <string>
+
+namespace evo::behavior {
+
+/**
+ * @brief Represents a sequence node whose children may change at runtime.
+ *
+ * The node behaves like Sequence over its current children; see
+ * DynamicComposite for how children are submitted. When finished children are
+ * consumed, each child is removed once it succeeds, so the node works through
+ * its children like a queue of jobs and succeeds when the queue is empty.
+ */
+class DynamicSequence : public DynamicComposite {
+public:
+  /**
+   * @brief Constructs a new DynamicSequence object.
+   *
+   * @param description A text description for behavior tree viewer.
+   * @param children The initial child nodes.
+   */
+  DynamicSequence(const std::string &description, const Children &children);
+
+  /**
+   * @brief Executes the node's logic.
+   *
+   * @return Status::Success if all child nodes return Status::Success.
+   * @return Status::Failure or Status::Running as returned by the first child
+   * node which does not succeed.
+   */
+  Status operator()() override;
+};
+
+} // namespace evo::behavior
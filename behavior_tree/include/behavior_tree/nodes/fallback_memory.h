@@ -7,6 +7,8 @@
 
 namespace evo::behavior {
 
+class FlatTree;
+
 /**
  * @brief Represents a control node which contains child nodes and calls them
  * sequentially until any of the child nodes returns Status::Success. If a child
@@ -35,11 +37,14 @@ public:
   Status operator()() override;
 
   /**
-   * @brief Resets the iteration over child nodes to the beginning.
+   * @brief Resets the iteration over child nodes to the beginning. Child nodes
+   * are reset lazily when they are ticked next time.
    */
   void reset() override;
 
 private:
+  friend class FlatTree;
+
   /// Iterator to keep track of the current child being processed.
   Children::const_iterator current_child_;
 };
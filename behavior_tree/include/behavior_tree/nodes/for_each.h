@@ -0,0 +1,126 @@
+#pragma once
+
+#include "../thread_pool.h"
+#include "behavior_node.h"
+#include "status.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief Settings of a ForEach node.
+ */
+struct ForEachPolicy {
+  /// How the results of the items are combined.
+  enum Mode {
+    /// Succeeds if every item succeeds.
+    ALL,
+    /// Succeeds if any item succeeds.
+    ANY,
+    /// Succeeds if at least threshold items succeed.
+    AT_LEAST
+  };
+
+  /// How the results of the items are combined.
+  Mode mode = ALL;
+  /// The number of successful items required in AT_LEAST mode.
+  std::size_t threshold = 1;
+  /// The number of consecutive items evaluated together.
+  std::size_t chunk_size = 64;
+  /// The pool spreading the chunks over threads, if any.
+  std::shared_ptr<ThreadPool> pool;
+  /// The smallest number of items which are evaluated on the pool.
+  std::size_t parallel_items = 256;
+};
+
+/**
+ * @brief Represents a control node which ticks one subtree per item of a
+ * collection and combines their results.
+ *
+ * The subtree of item i is built by a factory the first time the collection
+ * has an item i, becomes the node's child i and is reused in later ticks; it
+ * typically reads the item by its index. The node succeeds once enough items
+ * succeed and fails once too many fail to reach that, see ForEachPolicy;
+ * otherwise it is running.
+ *
+ * Items are evaluated in chunks of consecutive items. Small collections are
+ * evaluated on the ticking thread, which stops as soon as the result is
+ * decided and honors the tick's budget. Collections of at least
+ * policy.parallel_items items are spread over the pool chunk by chunk; all
+ * items are then ticked, without budget, load shedding or tick observers,
+ * so their subtrees must not share state.
+ */
+class ForEach : public BehaviorNode {
+public:
+  /// Returns the number of items.
+  using SizeFunction = std::function<std::size_t()>;
+  /// Builds the subtree of the item with the given index.
+  using ItemFactory = std::function<BehaviorPtr(std::size_t)>;
+
+  /**
+   * @brief Constructs a new ForEach object.
+   *
+   * @param description A text description for behavior tree viewer.
+   * @param size Returns the number of items, called at the start of each
+   * tick.
+   * @param item Builds the subtree of an item.
+   * @param policy Settings of the node.
+   * @throws std::invalid_argument If a function is empty or the chunk size is
+   * zero.
+   */
+  ForEach(const std::string &description, SizeFunction size, ItemFactory item,
+          ForEachPolicy policy = {});
+
+  /**
+   * @brief Executes the node's logic.
+   *
+   * @return Status The combined result of the items.
+   */
+  Status operator()() override;
+
+  void reset() override;
+
+  /**
+   * @brief Builds the subtrees of the collection's current items.
+   */
+  void preallocate() override;
+
+private:
+  /// The results of a range of items.
+  struct Counts {
+    std::size_t success = 0;
+    std::size_t failure = 0;
+    std::size_t running = 0;
+  };
+
+  /// Returns the combined result, or Incomplete if it is not decided yet.
+  Status decide(const Counts &counts, bool complete) const;
+
+  /// Builds the subtrees of items up to the given count.
+  void build_items(std::size_t count);
+
+  /// Ticks all items across the pool.
+  Status tick_parallel();
+
+  /// Returns the number of successes the node requires.
+  std::size_t required() const;
+
+  /// Returns the number of items.
+  SizeFunction size_;
+  /// Builds the subtree of an item.
+  ItemFactory item_;
+  /// Settings of the node.
+  ForEachPolicy policy_;
+  /// The number of items in the current tick.
+  std::size_t count_ = 0;
+  /// The results of the items ticked so far in the current tick.
+  Counts counts_;
+  /// The results of each chunk when evaluating on the pool.
+  std::vector<Counts> chunk_counts_;
+};
+
+} // namespace evo::behavior
@@ -12,10 +12,6 @@ public:
          BehaviorPtr then_node);
 
   Status operator()() override;
-
-private:
-  BehaviorPtr if_node_;
-  BehaviorPtr then_node_;
 };
 
 } // namespace evo::behavior
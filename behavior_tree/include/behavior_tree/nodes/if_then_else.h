@@ -37,14 +37,6 @@ public:
    * of the 'then' or 'else' node.
    */
   Status operator()() override;
-
-private:
-  /// Pointer to the node that evaluates the "if" condition.
-  BehaviorPtr if_node_;
-  /// Pointer to the node that is executed if the "if" condition is true.
-  BehaviorPtr then_node_;
-  /// Pointer to the node that is executed if the "if" condition is false.
-  BehaviorPtr else_node_;
 };
 
 } // namespace evo::behavior
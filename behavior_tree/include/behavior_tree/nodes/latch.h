@@ -8,6 +8,8 @@
 
 namespace evo::behavior {
 
+class FlatTree;
+
 /**
  * @brief Represents a control node which contains one child node and maintains
  * its state until explicitly unlatched.
@@ -43,7 +45,14 @@ public:
    */
   BehaviorPtr make_unlatcher();
 
+  /**
+   * @brief Unlatches the node, so that its child is ticked on the next call.
+   */
+  void unlatch();
+
 private:
+  friend class FlatTree;
+
   /// Indicates whether the node is currently latched.
   bool latched_;
   /// Stores the last result of the child node.
@@ -51,4 +60,28 @@ private:
       Status::Failure; // Default to failure unless proven otherwise
 };
 
+/**
+ * @brief Represents an action node which unlatches a Latch node.
+ */
+class Unlatch : public Action {
+public:
+  /**
+   * @brief Constructs a new Unlatch object.
+   *
+   * @param latch The node to unlatch. It must outlive this node.
+   */
+  explicit Unlatch(Latch &latch);
+
+  /**
+   * @brief Returns the node this action unlatches.
+   *
+   * @return Latch& The node to unlatch.
+   */
+  Latch &latch() const;
+
+private:
+  /// The node to unlatch.
+  Latch *latch_;
+};
+
 } // namespace evo::behavior
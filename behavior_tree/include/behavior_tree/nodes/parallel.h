@@ -36,6 +36,10 @@ public:
    * running.
    */
   Status operator()() override;
+
+private:
+  /// Whether all children ticked so far in the current tick have succeeded.
+  bool all_success_ = true;
 };
 
 } // namespace evo::behavior
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "behavior_node.h"
+#include "status.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief Base class for control nodes with memory whose children are
+ * described by a count and a generator instead of being built up front.
+ *
+ * @details Only a window of the most recently ticked children is
+ * instantiated; children() returns that window. When a child leaves the
+ * window, its subtree is reset and kept in a pool, and the generator may
+ * reuse it for the next child instead of building a new subtree. Use size()
+ * and child() to inspect the children which are not instantiated.
+ */
+class ProceduralComposite : public BehaviorNode {
+public:
+  /**
+   * @brief Builds the subtree of the child with the given index. It may
+   * reconfigure and return the recycled subtree, if one is given, or build a
+   * new one.
+   */
+  using Generator =
+      std::function<BehaviorPtr(std::size_t index, BehaviorPtr recycled)>;
+
+  /**
+   * @brief Constructs a new ProceduralComposite object.
+   *
+   * @param type The type of the node.
+   * @param description A text description for behavior tree viewer.
+   * @param count The number of children.
+   * @param generator Builds the subtrees of the children.
+   * @param window The number of children kept instantiated, at least one.
+   * @throws std::invalid_argument If the generator is empty or the window is
+   * zero.
+   */
+  ProceduralComposite(const std::string &type, const std::string &description,
+                      std::size_t count, Generator generator,
+                      std::size_t window = 1);
+
+  /**
+   * @brief Returns the number of children, instantiated or not.
+   *
+   * @return std::size_t The number of children.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Builds a new subtree of a child for inspection. It is not ticked
+   * and does not affect the instantiated children.
+   *
+   * @param index The index of the child.
+   * @return BehaviorPtr The subtree of the child.
+   * @throws std::out_of_range If there is no child at the index.
+   */
+  BehaviorPtr child(std::size_t index) const;
+
+  /**
+   * @brief Returns the index of the child which is ticked next.
+   *
+   * @return std::size_t The index of the current child.
+   */
+  std::size_t current() const;
+
+  /**
+   * @brief Resets the node to start over with the first child.
+   */
+  void reset() override;
+
+  /**
+   * @brief Instantiates the window of children starting at the current one.
+   */
+  void preallocate() override;
+
+protected:
+  /**
+   * @brief Ticks the children from the current one until one of them returns
+   * a status other than pass_status, which it keeps ticking in the next tick.
+   * When all children returned pass_status, the node starts over.
+   *
+   * @param pass_status The status which lets the evaluation continue.
+   * @return Status The first status other than pass_status, or pass_status if
+   * all children returned it.
+   */
+  Status tick_children(const Status &pass_status);
+
+private:
+  /// Returns the subtree of a child, instantiating it if needed.
+  const BehaviorPtr &instantiate(std::size_t index);
+
+  /// The number of children.
+  std::size_t count_;
+  /// Builds the subtrees of the children.
+  Generator generator_;
+  /// The number of children kept instantiated.
+  std::size_t window_;
+  /// The index of each instantiated child, parallel to children().
+  std::vector<std::size_t> indices_;
+  /// Subtrees which left the window, for reuse.
+  Children pool_;
+  /// The index of the child which is ticked next.
+  std::size_t current_ = 0;
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "procedural_composite.h"
+#include "status.h"
+#include <string>
+
+namespace evo::behavior {
+
+/**
+ * @brief Represents a sequence with memory whose children are generated on
+ * demand.
+ *
+ * The node behaves like SequenceMemory over size() children, but only
+ * instantiates a window of them; see ProceduralComposite.
+ */
+class ProceduralSequence : public ProceduralComposite {
+public:
+  /**
+   * @brief Constructs a new ProceduralSequence object.
+   *
+   * @param description A text description for behavior tree viewer.
+   * @param count The number of children.
+   * @param generator Builds the subtrees of the children.
+   * @param window The number of children kept instantiated.
+   */
+  ProceduralSequence(const std::string &description, std::size_t count,
+                     Generator generator, std::size_t window = 1);
+
+  /**
+   * @brief Executes the node's logic.
+   *
+   * @return Status::Success once all children have succeeded.
+   * @return Status::Failure or Status::Running as returned by the current
+   * child, which is ticked again in the next tick.
+   */
+  Status operator()() override;
+};
+
+} // namespace evo::behavior
@@ -7,6 +7,8 @@
 
 namespace evo::behavior {
 
+class FlatTree;
+
 /**
  * @brief Represents a control node which contains child nodes and calls them
  * sequentially, remembering the last successfully executed child. Execution
@@ -36,11 +38,14 @@ public:
   Status operator()() override;
 
   /**
-   * @brief Resets the sequence to start from the first child node.
+   * @brief Resets the sequence to start from the first child node. Child nodes
+   * are reset lazily when they are ticked next time.
    */
   void reset() override;
 
 private:
+  friend class FlatTree;
+
   /// Iterator to track the current child being executed.
   Children::const_iterator current_child_;
 };
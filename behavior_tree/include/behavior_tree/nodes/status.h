@@ -8,10 +8,13 @@ namespace evo::behavior {
  * @brief A class to represent status with three states: Success, Failure, and
  * Running.
  *
+ * A fourth state, Incomplete, is only returned by budgeted ticks which ran out
+ * of time before the traversal finished. Such a traversal resumes from the
+ * same point on the next tick.
  */
 class Status {
 public:
-  enum State { FAILURE, SUCCESS, RUNNING };
+  enum State { FAILURE, SUCCESS, RUNNING, INCOMPLETE };
 
   Status(bool success);
   Status(State state);
@@ -31,6 +34,7 @@ public:
   static const Status Success;
   static const Status Failure;
   static const Status Running;
+  static const Status Incomplete;
 
   friend std::ostream &operator<<(std::ostream &os, const Status &status);
 
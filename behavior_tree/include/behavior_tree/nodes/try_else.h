@@ -37,12 +37,6 @@ public:
    * nodes fail, and Status::Running if execution is not complete.
    */
   Status operator()() override;
-
-private:
-  /// The child node representing the normal case.
-  BehaviorPtr try_node_;
-  /// The child node representing the emergency case.
-  BehaviorPtr else_node_;
 };
 
 } // namespace evo::behavior
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "behavior_node.h"
+#include "status.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief Base class for control nodes whose children may be evaluated in any
+ * order. The node measures each child's cost and how often the child ends the
+ * evaluation, and reorders children after every tick to minimize the expected
+ * cost of a tick.
+ *
+ * @details Children are ranked by cost divided by the rate at which they end
+ * the evaluation; ties are broken by declaration order, so untested children
+ * keep their declaration order. The order can be frozen to reproduce behavior
+ * while debugging.
+ */
+class UnorderedComposite : public BehaviorNode {
+public:
+  /**
+   * @brief Statistics collected for a child node.
+   */
+  struct ChildStats {
+    /// Smoothed cost of ticking the child, in nanoseconds.
+    double cost = 0.0;
+    /// Smoothed fraction of ticks in which the child ended the evaluation.
+    double stop_rate = 0.5;
+    /// Number of ticks the statistics are based on.
+    std::size_t samples = 0;
+  };
+
+  /**
+   * @brief Constructs a new UnorderedComposite object.
+   *
+   * @param type The type of the node.
+   * @param description A text description for behavior tree viewer.
+   * @param children Child nodes.
+   * @param smoothing Weight of the newest measurement in the statistics.
+   */
+  UnorderedComposite(const std::string &type, const std::string &description,
+                     const Children &children, double smoothing = 0.1);
+
+  /**
+   * @brief Returns the order in which child nodes are evaluated.
+   *
+   * @return const std::vector<std::size_t>& Indices into children().
+   */
+  const std::vector<std::size_t> &order() const;
+
+  /**
+   * @brief Sets the order in which child nodes are evaluated.
+   *
+   * @param order A permutation of indices into children().
+   */
+  void set_order(const std::vector<std::size_t> &order);
+
+  /**
+   * @brief Returns the statistics collected for the child nodes.
+   *
+   * @return const std::vector<ChildStats>& Statistics in declaration order.
+   */
+  const std::vector<ChildStats> &stats() const;
+
+  /**
+   * @brief Freezes or unfreezes the evaluation order. Statistics are still
+   * collected while the order is frozen.
+   *
+   * @param frozen Whether the order must stay as it is.
+   */
+  void freeze(bool frozen = true);
+
+  /**
+   * @brief Checks whether the evaluation order is frozen.
+   *
+   * @return true if the order is frozen.
+   */
+  bool frozen() const;
+
+protected:
+  /**
+   * @brief Ticks child nodes in the current order until one of them returns a
+   * status other than pass_status.
+   *
+   * @param pass_status The status which lets the evaluation continue.
+   * @return Status The first status other than pass_status, or pass_status if
+   * all children returned it.
+   */
+  Status tick_in_order(const Status &pass_status);
+
+private:
+  /// Sorts children by the expected cost of evaluating them first.
+  void reorder();
+
+  /// Weight of the newest measurement in the statistics.
+  double smoothing_;
+  /// Whether the evaluation order is frozen.
+  bool frozen_ = false;
+  /// Evaluation order, indices into children().
+  std::vector<std::size_t> order_;
+  /// Per-child statistics in declaration order.
+  std::vector<ChildStats> stats_;
+};
+
+} // namespace evo::behavior
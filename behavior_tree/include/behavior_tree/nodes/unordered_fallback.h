@@ -0,0 +1,37 @@
+#pragma once
+
+#include "status.h"
+#include "unordered_composite.h"
+#include <string>
+
+namespace evo::behavior {
+
+/**
+ * @brief Represents a fallback node whose children may be tried in any order.
+ *
+ * The node behaves like Fallback, but tries first the children which are cheap
+ * and likely to succeed, according to statistics collected at runtime. Use it
+ * only when the order of the children does not matter logically.
+ */
+class UnorderedFallback : public UnorderedComposite {
+public:
+  /**
+   * @brief Constructs a new UnorderedFallback object.
+   *
+   * @param description A text description for behavior tree viewer.
+   * @param children Child nodes.
+   */
+  UnorderedFallback(const std::string &description, const Children &children);
+
+  /**
+   * @brief Executes the node's logic.
+   *
+   * @return Status::Success if any child node returns Status::Success.
+   * @return Status::Running if a child node returns Status::Running before any
+   * child succeeds.
+   * @return Status::Failure if all child nodes return Status::Failure.
+   */
+  Status operator()() override;
+};
+
+} // namespace evo::behavior
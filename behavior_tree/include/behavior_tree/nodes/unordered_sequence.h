@@ -0,0 +1,36 @@
+#pragma once
+
+#include "status.h"
+#include "unordered_composite.h"
+#include <string>
+
+namespace evo::behavior {
+
+/**
+ * @brief Represents a sequence node whose children may be ticked in any order.
+ *
+ * The node behaves like Sequence, but ticks first the children which are cheap
+ * and likely to fail, according to statistics collected at runtime. Use it only
+ * when the order of the children does not matter logically.
+ */
+class UnorderedSequence : public UnorderedComposite {
+public:
+  /**
+   * @brief Constructs a new UnorderedSequence object.
+   *
+   * @param description A text description for behavior tree viewer.
+   * @param children Child nodes.
+   */
+  UnorderedSequence(const std::string &description, const Children &children);
+
+  /**
+   * @brief Executes the node's logic.
+   *
+   * @return Status::Success if all child nodes return Status::Success.
+   * @return Status::Failure or Status::Running as returned by the first child
+   * node which does not succeed.
+   */
+  Status operator()() override;
+};
+
+} // namespace evo::behavior
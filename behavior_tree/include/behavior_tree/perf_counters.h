@@ -0,0 +1,121 @@
+#pragma once
+
+#include "tick_observer.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief A tick observer which attributes hardware performance counters to
+ * nodes.
+ *
+ * On Linux the counters are read with perf_event_open as one group of user
+ * space events of the ticking thread. Each node gets inclusive totals, which
+ * cover its subtree, and exclusive totals, which leave out the children it
+ * ticks; the exclusive totals of control nodes show the library's own
+ * overhead. The cost of reading the counters falls into the exclusive totals
+ * of the parent nodes.
+ *
+ * If the counters cannot be opened, e.g. on other platforms or when
+ * /proc/sys/kernel/perf_event_paranoid forbids it, available() returns false
+ * and only tick counts are collected.
+ */
+class PerfCounters : public TickObserver {
+public:
+  /// The measured events.
+  enum Event { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, EVENT_COUNT };
+
+  /// Counter values, indexed by Event.
+  using Counts = std::array<std::uint64_t, EVENT_COUNT>;
+
+  /**
+   * @brief Counters attributed to one node.
+   */
+  struct NodeCounters {
+    /// The number of times the node was ticked.
+    std::uint64_t ticks = 0;
+    /// Counts of the node's ticks, including its children.
+    Counts inclusive{};
+    /// Counts of the node's ticks, excluding its children.
+    Counts exclusive{};
+  };
+
+  /**
+   * @brief Opens the counters for the calling thread, which must be the
+   * thread ticking the tree.
+   */
+  PerfCounters();
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  /**
+   * @brief Closes the counters.
+   */
+  ~PerfCounters() override;
+
+  /**
+   * @brief Tells whether hardware counters are measured.
+   *
+   * @return true If the counters could be opened.
+   */
+  bool available() const;
+
+  /**
+   * @brief Returns the events which could be opened; the others count zero.
+   *
+   * @return std::vector<Event> The measured events.
+   */
+  std::vector<Event> events() const;
+
+  /**
+   * @brief Returns the name of an event, e.g. "cycles".
+   *
+   * @param event The event.
+   * @return std::string The event's name.
+   */
+  static std::string name(Event event);
+
+  /**
+   * @brief Returns the counters of the ticked nodes.
+   *
+   * @return const std::unordered_map<const BehaviorNode *, NodeCounters>&
+   * Counters by node.
+   */
+  const std::unordered_map<const BehaviorNode *, NodeCounters> &nodes() const;
+
+  /**
+   * @brief Drops all collected counters.
+   */
+  void clear();
+
+  void on_enter(const BehaviorNode &node) override;
+  void on_exit(const BehaviorNode &node, Status status) override;
+
+private:
+  /// A node being ticked.
+  struct Frame {
+    /// Counter values when the node was entered.
+    Counts start;
+    /// Inclusive counts of the node's children so far.
+    Counts children;
+  };
+
+  /// Reads the current counter values.
+  Counts read() const;
+
+  /// File descriptors of the events, -1 for events which are not measured.
+  std::array<int, EVENT_COUNT> fds_;
+  /// The file descriptor of the group leader, -1 if there are no counters.
+  int leader_ = -1;
+  /// Nodes being ticked, innermost last.
+  std::vector<Frame> stack_;
+  /// Counters by node.
+  std::unordered_map<const BehaviorNode *, NodeCounters> nodes_;
+};
+
+} // namespace evo::behavior
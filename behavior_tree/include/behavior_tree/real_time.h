@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace evo::behavior {
+
+/**
+ * @brief Detects heap allocations made by the current thread while the guard
+ * is alive.
+ *
+ * Guards only see allocations in executables linked with the
+ * behavior_tree_allocation_hooks library, which replaces the global operator
+ * new; each allocation is then reported to the innermost guard of the
+ * allocating thread. Allocations which bypass operator new, e.g. direct
+ * malloc() calls, are not seen.
+ */
+class AllocationGuard {
+public:
+  /// What an allocation under the guard does.
+  enum Action {
+    /// Count the allocation.
+    COUNT,
+    /// Print a message and abort the process.
+    ABORT
+  };
+
+#ifdef NDEBUG
+  /// Release builds count allocations.
+  static constexpr Action default_action = COUNT;
+#else
+  /// Debug builds abort on allocations.
+  static constexpr Action default_action = ABORT;
+#endif
+
+  /**
+   * @brief Installs the guard for the current thread.
+   *
+   * @param action What an allocation under the guard does.
+   */
+  explicit AllocationGuard(Action action = default_action);
+
+  AllocationGuard(const AllocationGuard &) = delete;
+  AllocationGuard &operator=(const AllocationGuard &) = delete;
+
+  /**
+   * @brief Restores the previously installed guard.
+   */
+  ~AllocationGuard();
+
+  /**
+   * @brief Returns the number of allocations seen by the guard.
+   *
+   * @return std::uint64_t The number of allocations.
+   */
+  std::uint64_t allocations() const;
+
+  /**
+   * @brief Reports an allocation to the guard of the current thread, if any.
+   * Called by the replaced operator new.
+   */
+  static void record();
+
+  /**
+   * @brief Checks whether allocations through operator new reach the guards,
+   * i.e. the executable is linked with the allocation hooks.
+   *
+   * @return true if guards see allocations.
+   */
+  static bool available();
+
+private:
+  /// What an allocation under the guard does.
+  Action action_;
+  /// The number of allocations seen by the guard.
+  std::uint64_t allocations_ = 0;
+  /// The guard installed before this one.
+  AllocationGuard *previous_;
+};
+
+/**
+ * @brief Settings of real-time mode, see BehaviorTree::set_real_time().
+ */
+struct RealTimePolicy {
+  /// Bytes reserved in the scratch arena of the tick's context.
+  std::size_t scratch_bytes = 0;
+  /// Whether to lock the current and future memory of the process into RAM.
+  bool lock_memory = false;
+  /// Bytes of the calling thread's stack to fault in advance.
+  std::size_t prefault_stack = 0;
+  /// Bytes of heap to fault in advance and keep in the process.
+  std::size_t prefault_heap = 0;
+  /// What an allocation during a tick does.
+  AllocationGuard::Action on_allocation = AllocationGuard::default_action;
+};
+
+/**
+ * @brief Locks and faults in memory as the policy requests, so that ticks do
+ * not take page faults.
+ *
+ * @param policy Settings of real-time mode.
+ * @return true if the memory could be locked or locking was not requested.
+ */
+bool prepare_real_time_memory(const RealTimePolicy &policy);
+
+} // namespace evo::behavior
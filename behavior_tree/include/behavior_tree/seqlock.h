@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace evo::behavior {
+
+/**
+ * @brief A sequence lock: a single writer updates data without ever waiting,
+ * and readers detect and retry reads which overlapped a write.
+ *
+ * The lock only holds a counter, which is odd while a write is in progress,
+ * so it may be placed in memory shared between processes. Readers must copy
+ * the data before using it and discard the copy if try_read() fails.
+ */
+class SeqLock {
+public:
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                "SeqLock requires lock-free 64-bit atomics");
+
+  /**
+   * @brief Updates the data protected by the lock. Only one thread may write
+   * at a time.
+   *
+   * @param write Writes the data.
+   */
+  template <class Write> void write(Write &&write) {
+    auto sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    write();
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief Reads the data protected by the lock once, without waiting.
+   *
+   * @param read Copies the data.
+   * @return true If the copy is consistent; false if it overlapped a write and
+   * must be discarded.
+   */
+  template <class Read> bool try_read(Read &&read) const {
+    auto sequence = sequence_.load(std::memory_order_acquire);
+    if (sequence & 1) {
+      return false;
+    }
+    read();
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return sequence_.load(std::memory_order_relaxed) == sequence;
+  }
+
+  /**
+   * @brief Reads the data protected by the lock, retrying until the copy is
+   * consistent.
+   *
+   * @param read Copies the data.
+   */
+  template <class Read> void read(Read &&read) const {
+    while (!try_read(read)) {
+    }
+  }
+
+  /**
+   * @brief Returns the number of completed writes.
+   *
+   * @return std::uint64_t The number of completed writes.
+   */
+  std::uint64_t writes() const {
+    return sequence_.load(std::memory_order_acquire) / 2;
+  }
+
+private:
+  /// Twice the number of completed writes, plus one during a write.
+  std::atomic<std::uint64_t> sequence_{0};
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "seqlock.h"
+#include "shared_segment.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief A typed handle of a slot of a SharedBlackboard.
+ *
+ * A handle is only valid for boards with the layout it was obtained from.
+ *
+ * @tparam T The type of the slot's value.
+ */
+template <class T> class BlackboardSlot {
+public:
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Blackboard values must be trivially copyable");
+  static_assert(alignof(T) <= 64, "Blackboard values must align to 64 bytes");
+
+  /// The offset of the value from the slot's sequence lock.
+  static constexpr std::size_t value_offset =
+      alignof(T) > sizeof(SeqLock) ? alignof(T) : sizeof(SeqLock);
+
+  /**
+   * @brief Constructs an invalid handle.
+   */
+  BlackboardSlot() = default;
+
+  /**
+   * @brief Returns the offset of the slot in the segment.
+   *
+   * @return std::size_t The offset.
+   */
+  std::size_t offset() const { return offset_; }
+
+private:
+  friend class BlackboardLayout;
+  friend class SharedBlackboard;
+
+  explicit BlackboardSlot(std::size_t offset) : offset_(offset) {}
+
+  /// The offset of the slot's sequence lock in the segment.
+  std::size_t offset_ = 0;
+};
+
+/**
+ * @brief The fixed set of named, typed slots of a SharedBlackboard.
+ */
+class BlackboardLayout {
+public:
+  /// The description of a slot.
+  struct SlotInfo {
+    /// The name of the slot.
+    std::string name;
+    /// The size of the value.
+    std::uint32_t size;
+    /// The alignment of the value.
+    std::uint32_t align;
+    /// The offset of the slot in the segment.
+    std::uint64_t offset;
+  };
+
+  /**
+   * @brief Adds a slot.
+   *
+   * @tparam T The type of the slot's value, which must be trivially copyable
+   * and have the same representation in all processes sharing the board.
+   * @param name The name of the slot.
+   * @return BlackboardSlot<T> The handle of the slot.
+   * @throws std::invalid_argument If the name is taken.
+   */
+  template <class T> BlackboardSlot<T> add(const std::string &name) {
+    return BlackboardSlot<T>(
+        add(name, sizeof(T), alignof(T), BlackboardSlot<T>::value_offset));
+  }
+
+  /**
+   * @brief Returns the slots in the order they were added.
+   *
+   * @return const std::vector<SlotInfo>& The slots.
+   */
+  const std::vector<SlotInfo> &slots() const { return slots_; }
+
+private:
+  friend class SharedBlackboard;
+
+  /// Adds a slot and returns its offset.
+  std::size_t add(const std::string &name, std::size_t size, std::size_t align,
+                  std::size_t value_offset);
+
+  /// The slots.
+  std::vector<SlotInfo> slots_;
+  /// The end of the last slot in the segment, which starts after the header.
+  std::size_t size_ = 64;
+};
+
+/**
+ * @brief A blackboard in a named POSIX shared memory segment, through which
+ * processes exchange their latest values.
+ *
+ * Each slot holds a value guarded by its own sequence lock, on separate cache
+ * lines, so readers copy the latest value straight out of shared memory
+ * without system calls and never block the writer. Every slot must have a
+ * single writer at a time, in any process.
+ *
+ * The creating process owns the segment and removes it when its board is
+ * destroyed; other processes open it by name and look up their slots.
+ */
+class SharedBlackboard {
+public:
+  /**
+   * @brief Creates the segment, with all values zero.
+   *
+   * @param name The name of the segment, starting with '/'.
+   * @param layout The slots of the board.
+   * @throws std::system_error If the segment cannot be created.
+   */
+  SharedBlackboard(const std::string &name, const BlackboardLayout &layout);
+
+  /**
+   * @brief Opens a segment created by another board.
+   *
+   * @param name The name of the segment.
+   * @throws std::system_error If the segment cannot be opened.
+   * @throws std::runtime_error If it is not a blackboard segment.
+   */
+  explicit SharedBlackboard(const std::string &name);
+
+  SharedBlackboard(const SharedBlackboard &) = delete;
+  SharedBlackboard &operator=(const SharedBlackboard &) = delete;
+
+  /**
+   * @brief Unmaps the segment, and removes it if this board created it.
+   */
+  ~SharedBlackboard();
+
+  /**
+   * @brief Looks up a slot by name.
+   *
+   * @tparam T The type of the slot's value.
+   * @param name The name of the slot.
+   * @return BlackboardSlot<T> The handle of the slot.
+   * @throws std::out_of_range If there is no such slot.
+   * @throws std::invalid_argument If the slot holds another type.
+   */
+  template <class T> BlackboardSlot<T> slot(const std::string &name) const {
+    const auto &info = find(name);
+    if (info.size != sizeof(T) || info.align != alignof(T)) {
+      throw std::invalid_argument("Blackboard slot '" + name +
+                                  "' holds another type");
+    }
+    return BlackboardSlot<T>(info.offset);
+  }
+
+  /**
+   * @brief Writes the value of a slot.
+   *
+   * @param slot The slot.
+   * @param value The new value.
+   */
+  template <class T> void write(BlackboardSlot<T> slot, const T &value) {
+    lock(slot).write(
+        [&] { std::memcpy(address(slot), &value, sizeof(T)); });
+  }
+
+  /**
+   * @brief Reads the value of a slot once, without waiting.
+   *
+   * @param slot The slot.
+   * @param value Receives the value.
+   * @return true If the value was read; false if it overlapped a write.
+   */
+  template <class T> bool try_read(BlackboardSlot<T> slot, T &value) const {
+    T copy;
+    if (!lock(slot).try_read(
+            [&] { std::memcpy(&copy, address(slot), sizeof(T)); })) {
+      return false;
+    }
+    value = copy;
+    return true;
+  }
+
+  /**
+   * @brief Reads the value of a slot, retrying while it is being written.
+   *
+   * @param slot The slot.
+   * @return T The latest value.
+   */
+  template <class T> T read(BlackboardSlot<T> slot) const {
+    T value;
+    lock(slot).read([&] { std::memcpy(&value, address(slot), sizeof(T)); });
+    return value;
+  }
+
+  /**
+   * @brief Returns the number of writes of a slot, e.g. to detect new values.
+   *
+   * @param slot The slot.
+   * @return std::uint64_t The number of completed writes.
+   */
+  template <class T> std::uint64_t writes(BlackboardSlot<T> slot) const {
+    return lock(slot).writes();
+  }
+
+  /**
+   * @brief Returns the slots of the board.
+   *
+   * @return const std::vector<BlackboardLayout::SlotInfo>& The slots.
+   */
+  const std::vector<BlackboardLayout::SlotInfo> &slots() const;
+
+private:
+  /// Returns the slot with the given name.
+  const BlackboardLayout::SlotInfo &find(const std::string &name) const;
+
+  template <class T> SeqLock &lock(BlackboardSlot<T> slot) const {
+    return *reinterpret_cast<SeqLock *>(segment_.data() + slot.offset_);
+  }
+
+  template <class T> char *address(BlackboardSlot<T> slot) const {
+    return segment_.data() + slot.offset_ + BlackboardSlot<T>::value_offset;
+  }
+
+  /// The name of the segment.
+  std::string name_;
+  /// The mapped segment, owned if this board created it.
+  SharedSegment segment_;
+  /// The slots.
+  std::vector<BlackboardLayout::SlotInfo> slots_;
+};
+
+} // namespace evo::behavior
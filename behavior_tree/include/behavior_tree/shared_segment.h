@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace evo::behavior {
+
+/**
+ * @brief A mapping of a named POSIX shared memory segment, the storage of
+ * StatusPublisher and SharedBlackboard.
+ *
+ * Segments start with an 8-byte magic. The creator writes everything else
+ * first and the magic last, see publish(); openers check the magic before
+ * reading anything else, see published(). The creator owns the segment and
+ * removes it when its mapping is destroyed.
+ */
+class SharedSegment {
+public:
+  /// The size of the magic which starts a segment.
+  static constexpr std::size_t magic_size = 8;
+
+  /**
+   * @brief Constructs an empty mapping.
+   */
+  SharedSegment() = default;
+
+  /**
+   * @brief Creates or truncates a segment, zero filled, and maps it for
+   * reading and writing.
+   *
+   * @param name The name of the segment, starting with '/'.
+   * @param size The size of the segment.
+   * @return SharedSegment The mapping, which owns the segment.
+   * @throws std::system_error If the segment cannot be created.
+   */
+  static SharedSegment create(const std::string &name, std::size_t size);
+
+  /**
+   * @brief Maps an existing segment.
+   *
+   * @param name The name of the segment.
+   * @param writable Whether the mapping may be written.
+   * @param min_size The smallest size of a valid segment, e.g. its header.
+   * @param kind The kind of segment, for error messages.
+   * @return SharedSegment The mapping.
+   * @throws std::system_error If the segment cannot be opened.
+   * @throws std::runtime_error If it is smaller than min_size.
+   */
+  static SharedSegment open(const std::string &name, bool writable,
+                            std::size_t min_size, const std::string &kind);
+
+  SharedSegment(SharedSegment &&other) noexcept;
+  SharedSegment &operator=(SharedSegment &&other) noexcept;
+  SharedSegment(const SharedSegment &) = delete;
+  SharedSegment &operator=(const SharedSegment &) = delete;
+
+  /**
+   * @brief Unmaps the segment, and removes it if this mapping created it.
+   */
+  ~SharedSegment();
+
+  /**
+   * @brief Returns the start of the mapping.
+   *
+   * @return char* The first byte, nullptr for an empty mapping.
+   */
+  char *data() const { return data_; }
+
+  /**
+   * @brief Returns the size of the mapping.
+   *
+   * @return std::size_t The size in bytes.
+   */
+  std::size_t size() const { return size_; }
+
+  /**
+   * @brief Writes the magic, after everything written before it.
+   *
+   * @param magic The magic identifying the kind of segment.
+   */
+  void publish(const char (&magic)[magic_size]);
+
+  /**
+   * @brief Checks the magic; everything written before it may be read if it
+   * matches.
+   *
+   * @param magic The magic identifying the kind of segment.
+   * @return true If the segment was published with this magic.
+   */
+  bool published(const char (&magic)[magic_size]) const;
+
+private:
+  /// Unmaps the segment and removes it if owned.
+  void release();
+
+  /// The name of the segment.
+  std::string name_;
+  /// The mapped segment.
+  char *data_ = nullptr;
+  /// The size of the segment.
+  std::size_t size_ = 0;
+  /// Whether this mapping created the segment.
+  bool owner_ = false;
+};
+
+/**
+ * @brief Reads numbers and length-prefixed strings from a section of a
+ * shared segment, checking its bounds.
+ */
+class SegmentParser {
+public:
+  /**
+   * @brief Constructs a new SegmentParser object.
+   *
+   * @param data The start of the section.
+   * @param size The size of the section.
+   * @param section The name of the section, for error messages.
+   */
+  SegmentParser(const char *data, std::size_t size, std::string section)
+      : data_(data), size_(size), section_(std::move(section)) {}
+
+  /**
+   * @brief Reads a number.
+   *
+   * @tparam T The type of the number.
+   * @return T The number.
+   * @throws std::runtime_error If the section ends first.
+   */
+  template <class T> T number() {
+    T value;
+    std::memcpy(&value, take(sizeof(value)), sizeof(value));
+    return value;
+  }
+
+  /**
+   * @brief Reads a string stored as a uint32 length and its characters.
+   *
+   * @return std::string The string.
+   * @throws std::runtime_error If the section ends first.
+   */
+  std::string text();
+
+private:
+  /// Returns the next bytes of the section and moves past them.
+  const char *take(std::size_t size);
+
+  /// The start of the section.
+  const char *data_;
+  /// The size of the section.
+  std::size_t size_;
+  /// The name of the section.
+  std::string section_;
+  /// The position of the next read.
+  std::size_t position_ = 0;
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief A bounded lock-free queue for one producer thread and one consumer
+ * thread.
+ *
+ * @tparam T The type of the elements, which must be default constructible and
+ * copy assignable.
+ */
+template <class T> class SpscQueue {
+public:
+  /**
+   * @brief Constructs a new SpscQueue object.
+   *
+   * @param capacity The smallest number of elements the queue must hold; it is
+   * rounded up to a power of two.
+   */
+  explicit SpscQueue(std::size_t capacity) {
+    std::size_t size = 1;
+    while (size < capacity) {
+      size *= 2;
+    }
+    buffer_.resize(size);
+    mask_ = size - 1;
+  }
+
+  /**
+   * @brief Appends an element. Must only be called by the producer.
+   *
+   * @param value The element.
+   * @return true If the element was added; false if the queue is full.
+   */
+  bool push(const T &value) {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) > mask_) {
+      return false;
+    }
+    buffer_[tail & mask_] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest element. Must only be called by the consumer.
+   *
+   * @param value Receives the element.
+   * @return true If an element was removed; false if the queue is empty.
+   */
+  bool pop(T &value) {
+    auto head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = buffer_[head & mask_];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Returns the number of elements the queue holds at most.
+   *
+   * @return std::size_t The capacity.
+   */
+  std::size_t capacity() const { return buffer_.size(); }
+
+private:
+  /// The elements, indexed by position modulo the capacity.
+  std::vector<T> buffer_;
+  /// The capacity minus one.
+  std::size_t mask_ = 0;
+  /// The position of the oldest element, written by the consumer.
+  alignas(64) std::atomic<std::size_t> head_{0};
+  /// The position after the newest element, written by the producer.
+  alignas(64) std::atomic<std::size_t> tail_{0};
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "node_index.h"
+#include "nodes/behavior_node.h"
+#include "shared_segment.h"
+#include "tick_observer.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief A tick observer which publishes the live state of a tree into a
+ * POSIX shared memory segment for viewers in other processes.
+ *
+ * Nodes are numbered by a NodeIndex: in depth-first order from the root,
+ * shared nodes once.
+ * The segment starts with a header, followed by the topology, which is
+ * written once, and the state, which is written after each tick under a
+ * sequence lock, so the tick never waits for readers:
+ *
+ * - topology: for each node, its child count and child ids, then its type and
+ *   description, each as a length and characters; all integers are uint32;
+ * - statuses: 2 bits per node, four nodes per byte starting from the low
+ *   bits, holding the Status::State the node last returned;
+ * - last ticks: a uint64 per node, the number of the tick which last ticked
+ *   the node, 0 if none did.
+ *
+ * Use StatusReader to read the segment.
+ */
+class StatusPublisher : public TickObserver {
+public:
+  /**
+   * @brief Creates the segment and writes the topology of the tree.
+   *
+   * @param name The name of the segment, starting with '/'.
+   * @param root The root node of the tree.
+   * @throws std::invalid_argument If root is null.
+   * @throws std::system_error If the segment cannot be created.
+   */
+  StatusPublisher(const std::string &name, const BehaviorPtr &root);
+
+  /**
+   * @brief Creates the segment and writes the topology of a tree numbered by
+   * an index shared with other observers, e.g. BehaviorTree::node_index().
+   *
+   * @param name The name of the segment, starting with '/'.
+   * @param index The index of the tree's nodes.
+   * @throws std::invalid_argument If index is null or empty.
+   * @throws std::system_error If the segment cannot be created.
+   */
+  StatusPublisher(const std::string &name,
+                  std::shared_ptr<const NodeIndex> index);
+
+  StatusPublisher(const StatusPublisher &) = delete;
+  StatusPublisher &operator=(const StatusPublisher &) = delete;
+
+  /**
+   * @brief Unmaps and removes the segment.
+   */
+  ~StatusPublisher() override;
+
+  /**
+   * @brief Returns the number of published ticks.
+   *
+   * @return std::uint64_t The number of the latest tick.
+   */
+  std::uint64_t tick() const;
+
+  void on_enter(const BehaviorNode &node) override;
+  void on_exit(const BehaviorNode &node, Status status) override;
+
+private:
+  /// Copies the state of the latest tick into the segment.
+  void publish();
+
+  /// The mapped segment.
+  SharedSegment segment_;
+  /// Ids of the nodes.
+  std::shared_ptr<const NodeIndex> index_;
+  /// Packed statuses, as published.
+  std::vector<std::uint8_t> statuses_;
+  /// The tick which last ticked each node.
+  std::vector<std::uint64_t> last_ticks_;
+  /// The nesting depth of the current tick.
+  std::size_t depth_ = 0;
+  /// The number of the current tick.
+  std::uint64_t tick_ = 0;
+};
+
+/**
+ * @brief Reads a segment written by StatusPublisher.
+ */
+class StatusReader {
+public:
+  /**
+   * @brief A node of the published tree.
+   */
+  struct NodeInfo {
+    /// The node's type.
+    std::string type;
+    /// The node's description.
+    std::string description;
+    /// Ids of the node's children.
+    std::vector<std::uint32_t> children;
+  };
+
+  /**
+   * @brief The state of the tree after one tick.
+   */
+  struct Snapshot {
+    /// The number of the tick, 0 before the first tick.
+    std::uint64_t tick = 0;
+    /// The status each node last returned, by node id.
+    std::vector<Status> statuses;
+    /// The tick which last ticked each node, 0 if none did.
+    std::vector<std::uint64_t> last_ticks;
+  };
+
+  /**
+   * @brief Opens the segment and reads the topology.
+   *
+   * @param name The name of the segment.
+   * @throws std::system_error If the segment cannot be opened.
+   * @throws std::runtime_error If the segment has an unknown format.
+   */
+  explicit StatusReader(const std::string &name);
+
+  StatusReader(const StatusReader &) = delete;
+  StatusReader &operator=(const StatusReader &) = delete;
+
+  /**
+   * @brief Unmaps the segment.
+   */
+  ~StatusReader();
+
+  /**
+   * @brief Returns the nodes of the tree by id, the root first.
+   *
+   * @return const std::vector<NodeInfo>& The nodes.
+   */
+  const std::vector<NodeInfo> &topology() const;
+
+  /**
+   * @brief Reads the latest state once, without waiting.
+   *
+   * @param snapshot Receives the state.
+   * @return true If the state was read; false if the publisher was writing,
+   * in which case snapshot holds garbage.
+   */
+  bool try_read(Snapshot &snapshot) const;
+
+  /**
+   * @brief Reads the latest state, retrying while the publisher is writing.
+   *
+   * @param snapshot Receives the state.
+   */
+  void read(Snapshot &snapshot) const;
+
+private:
+  /// The mapped segment.
+  SharedSegment segment_;
+  /// The nodes of the tree.
+  std::vector<NodeInfo> topology_;
+  /// Buffer for the packed statuses.
+  mutable std::vector<std::uint8_t> packed_;
+};
+
+} // namespace evo::behavior
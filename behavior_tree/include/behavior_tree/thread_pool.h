@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief A fixed set of worker threads which run batches of independent
+ * tasks.
+ *
+ * The thread which submits a batch takes part in running it, so a pool with
+ * no workers runs batches sequentially on the calling thread.
+ */
+class ThreadPool {
+public:
+  /**
+   * @brief Starts the worker threads.
+   *
+   * @param workers The number of worker threads.
+   */
+  explicit ThreadPool(std::size_t workers = std::thread::hardware_concurrency());
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief Stops the worker threads.
+   */
+  ~ThreadPool();
+
+  /**
+   * @brief Returns the number of worker threads.
+   *
+   * @return std::size_t The number of worker threads.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Runs task(0), ..., task(count - 1) across the pool and waits until
+   * all of them are done. Batches submitted by several threads run one after
+   * another.
+   *
+   * @param count The number of tasks.
+   * @param task The task to run for each index.
+   * @throws The first exception thrown by a task, after all tasks are done.
+   */
+  void parallel_for(std::size_t count,
+                    const std::function<void(std::size_t)> &task);
+
+private:
+  /// Runs tasks of the current batch until none are left.
+  void drain();
+
+  /// Waits for batches and takes part in running them.
+  void work();
+
+  /// The worker threads.
+  std::vector<std::thread> workers_;
+  /// Serializes batches.
+  std::mutex batch_mutex_;
+  /// Protects the state of the current batch.
+  std::mutex mutex_;
+  /// Signals a new batch or shutdown to the workers.
+  std::condition_variable batch_started_;
+  /// Signals that no worker is running tasks.
+  std::condition_variable workers_idle_;
+  /// The task of the current batch.
+  const std::function<void(std::size_t)> *task_ = nullptr;
+  /// The number of tasks in the current batch.
+  std::size_t count_ = 0;
+  /// The index of the next task to run.
+  std::atomic<std::size_t> next_{0};
+  /// Incremented for every batch.
+  std::size_t generation_ = 0;
+  /// The number of workers running tasks of the current batch.
+  std::size_t busy_ = 0;
+  /// The first exception thrown by a task of the current batch.
+  std::exception_ptr error_;
+  /// Tells the workers to exit.
+  bool stopping_ = false;
+};
+
+} // namespace evo::behavior
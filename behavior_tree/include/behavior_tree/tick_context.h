@@ -0,0 +1,274 @@
+#pragma once
+
+#include "clock.h"
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief A monotonic memory resource for temporary allocations during a tick.
+ *
+ * Allocation bumps a pointer through blocks which are kept when the arena is
+ * reset, so after the first few ticks a tick allocates nothing from the heap.
+ * Deallocation does nothing; memory is reclaimed by reset(). Use it with the
+ * std::pmr containers, e.g. std::pmr::vector<int> v(&context.scratch()).
+ */
+class ScratchArena : public std::pmr::memory_resource {
+public:
+  /**
+   * @brief Constructs a new ScratchArena object. No memory is allocated until
+   * it is first used.
+   *
+   * @param block_size The size of the blocks the arena allocates.
+   */
+  explicit ScratchArena(std::size_t block_size = 64 * 1024);
+
+  /**
+   * @brief Constructs an empty arena with the same block size as another.
+   */
+  ScratchArena(const ScratchArena &other);
+
+  /**
+   * @brief Empties the arena and takes the block size of another.
+   */
+  ScratchArena &operator=(const ScratchArena &other);
+
+  ScratchArena(ScratchArena &&) = default;
+  ScratchArena &operator=(ScratchArena &&) = default;
+
+  /**
+   * @brief Makes all the memory of the arena available again. Objects
+   * allocated from it must no longer be used.
+   */
+  void reset();
+
+  /**
+   * @brief Allocates memory in advance, so that the arena holds at least the
+   * given number of bytes.
+   *
+   * @param bytes The capacity to reach.
+   */
+  void reserve(std::size_t bytes);
+
+  /**
+   * @brief Returns the number of bytes allocated since the latest reset,
+   * including padding.
+   *
+   * @return std::size_t The used bytes.
+   */
+  std::size_t used() const;
+
+  /**
+   * @brief Returns the number of bytes the arena holds.
+   *
+   * @return std::size_t The reserved bytes.
+   */
+  std::size_t capacity() const;
+
+protected:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void *, std::size_t, std::size_t) override {}
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override {
+    return this == &other;
+  }
+
+private:
+  /// A chunk of memory.
+  struct Block {
+    /// The memory.
+    std::unique_ptr<std::byte[]> data;
+    /// The size of the memory.
+    std::size_t size;
+  };
+
+  /// The size of the blocks the arena allocates.
+  std::size_t block_size_;
+  /// The blocks, reused after every reset.
+  std::vector<Block> blocks_;
+  /// The block allocations are taken from.
+  std::size_t current_ = 0;
+  /// The offset of the free memory in the current block.
+  std::size_t offset_ = 0;
+  /// The bytes of the blocks before the current one.
+  std::size_t used_before_ = 0;
+};
+
+/**
+ * @brief Per-tick state shared by all the nodes ticked by a tree.
+ *
+ * BehaviorTree installs its context for the current thread while it runs, and
+ * actions and conditions created with context-taking functions receive it as
+ * an argument. Other nodes may read it through TickContext::current().
+ */
+class TickContext {
+public:
+  /**
+   * @brief Installs a context for the current thread for the lifetime of the
+   * scope and restores the previous one afterwards.
+   */
+  class Scope {
+  public:
+    /**
+     * @brief Installs the context.
+     *
+     * @param context The context to install, or nullptr for none.
+     */
+    explicit Scope(TickContext *context);
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    /**
+     * @brief Restores the previously installed context.
+     */
+    ~Scope();
+
+  private:
+    /// The context installed before this scope.
+    TickContext *previous_;
+  };
+
+  /**
+   * @brief Constructs a new TickContext object.
+   *
+   * @param clock The clock the time of each tick is sampled from, or nullptr
+   * if the time is given to begin() only.
+   * @param user_data Data the nodes can reach during the tick, or nullptr.
+   */
+  explicit TickContext(const Clock *clock = nullptr,
+                       std::any *user_data = nullptr);
+
+  /**
+   * @brief Returns the context installed for the current thread.
+   *
+   * @return TickContext* The installed context, or nullptr if there is none.
+   */
+  static TickContext *current();
+
+  /**
+   * @brief Returns a context with the same time, tick counter, clock and user
+   * data, but its own scratch arena, for work done on behalf of the tick on
+   * another thread.
+   *
+   * @return TickContext The branched context.
+   */
+  TickContext branch() const;
+
+  /**
+   * @brief Starts a tick: samples its time and advances the tick counter.
+   */
+  void begin();
+
+  /**
+   * @brief Starts a tick at the given time and advances the tick counter.
+   *
+   * @param now The time of the tick.
+   */
+  void begin(Clock::TimePoint now);
+
+  /**
+   * @brief Ends a tick and resets the scratch arena.
+   */
+  void end();
+
+  /**
+   * @brief Returns the time sampled once at the start of the tick.
+   *
+   * @return Clock::TimePoint The time of the tick.
+   */
+  Clock::TimePoint now() const;
+
+  /**
+   * @brief Returns the clock the time is sampled from. Nodes with the same
+   * clock may use now() instead of reading it.
+   *
+   * @return const Clock* The clock, or nullptr.
+   */
+  const Clock *clock() const;
+
+  /**
+   * @brief Returns the number of the tick, starting from 1, e.g. to memoize
+   * results within a tick.
+   *
+   * @return std::uint64_t The tick counter.
+   */
+  std::uint64_t tick() const;
+
+  /**
+   * @brief Returns the arena for temporary allocations, which is reset at the
+   * end of the tick. Only for the thread running the tick.
+   *
+   * @return ScratchArena& The scratch arena.
+   */
+  ScratchArena &scratch();
+
+  /**
+   * @brief Returns the user data, if it holds a T.
+   *
+   * @tparam T The type of the user data.
+   * @return T* The user data, or nullptr if there is none or it is not a T.
+   */
+  template <class T> T *user_data() const {
+    return user_data_ ? std::any_cast<T>(user_data_) : nullptr;
+  }
+
+  /**
+   * @brief Sets the user data.
+   *
+   * @param user_data The user data, or nullptr for none.
+   */
+  void set_user_data(std::any *user_data);
+
+  /**
+   * @brief Sets the clock the time of each tick is sampled from.
+   *
+   * @param clock The clock, or nullptr.
+   */
+  void set_clock(const Clock *clock);
+
+private:
+  /// The clock the time of each tick is sampled from.
+  const Clock *clock_;
+  /// Data the nodes can reach during the tick.
+  std::any *user_data_;
+  /// The time of the tick.
+  Clock::TimePoint now_;
+  /// The number of the tick.
+  std::uint64_t tick_ = 0;
+  /// Temporary allocations of the tick.
+  ScratchArena scratch_;
+};
+
+/**
+ * @brief Returns the time of the current tick if it was sampled from the
+ * given clock, otherwise reads the clock.
+ *
+ * @param clock The clock.
+ * @return Clock::TimePoint The current time.
+ */
+Clock::TimePoint tick_time(const Clock &clock);
+
+/**
+ * @brief Calls a function with the context installed for the current thread,
+ * or with a detached context sampled from the default clock if there is none.
+ *
+ * @param function The function, taking TickContext&.
+ * @return decltype(auto) The result of the function.
+ */
+template <class Function> decltype(auto) with_tick_context(Function &&function) {
+  if (auto *context = TickContext::current()) {
+    return function(*context);
+  }
+  auto clock = default_clock();
+  TickContext detached(clock.get());
+  detached.begin();
+  return function(detached);
+}
+
+} // namespace evo::behavior
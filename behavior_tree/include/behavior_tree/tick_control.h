@@ -0,0 +1,173 @@
+#pragma once
+
+#include "clock.h"
+#include "nodes/status.h"
+#include "tick_observer.h"
+#include <optional>
+#include <vector>
+
+namespace evo::behavior {
+
+class BehaviorNode;
+class InterruptService;
+class LoadShedder;
+
+/**
+ * @brief Controls the traversal of a behavior tree during one tick.
+ *
+ * BehaviorTree installs a control for the current thread while it runs, and
+ * control nodes consult it through BehaviorNode::tick_child() before ticking
+ * each child. Without an installed control the traversal is never interrupted.
+ */
+class TickControl {
+public:
+  /**
+   * @brief Installs a control for the current thread for the lifetime of the
+   * scope and restores the previous one afterwards.
+   */
+  class Scope {
+  public:
+    /**
+     * @brief Installs the control.
+     *
+     * @param control The control to install, or nullptr for none.
+     */
+    explicit Scope(TickControl *control);
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    /**
+     * @brief Restores the previously installed control.
+     */
+    ~Scope();
+
+  private:
+    /// The control installed before this scope.
+    TickControl *previous_;
+  };
+
+  /**
+   * @brief Returns the control installed for the current thread.
+   *
+   * @return TickControl* The installed control, or nullptr if there is none.
+   */
+  static TickControl *current();
+
+  /**
+   * @brief Makes the traversal stop at the deadline.
+   *
+   * @param clock The clock used to check the deadline.
+   * @param deadline The time after which no more nodes are ticked.
+   */
+  void set_deadline(ClockPtr clock, Clock::TimePoint deadline);
+
+  /**
+   * @brief Makes the traversal skip nodes the shedder decides to shed.
+   *
+   * @param shedder The load shedder, or nullptr for none.
+   */
+  void set_load_shedder(LoadShedder *shedder);
+
+  /**
+   * @brief Makes the traversal notify observers around every ticked node.
+   *
+   * @param observers The observers, or nullptr for none.
+   */
+  void set_observers(const std::vector<TickObserver *> *observers);
+
+  /**
+   * @brief Makes the traversal service pending interrupts at node boundaries.
+   *
+   * @param interrupts The interrupt service, or nullptr for none.
+   */
+  void set_interrupts(InterruptService *interrupts);
+
+  /**
+   * @brief Ticks the pending interrupt subtrees, if any, before the traversal
+   * continues.
+   */
+  void poll_interrupts() {
+    if (interrupts_) {
+      service_interrupts();
+    }
+  }
+
+  /**
+   * @brief Notifies the observers that a node is about to be ticked.
+   *
+   * @param node The node about to be ticked.
+   */
+  void enter(const BehaviorNode &node) const {
+    if (observers_) {
+      for (auto *observer : *observers_) {
+        observer->on_enter(node);
+      }
+    }
+  }
+
+  /**
+   * @brief Notifies the observers that a node has been ticked.
+   *
+   * @param node The ticked node.
+   * @param status The status the node returned.
+   */
+  void exit(const BehaviorNode &node, Status status) const {
+    if (observers_) {
+      // Exits are reported in the reverse order of entries
+      for (auto it = observers_->rbegin(); it != observers_->rend(); ++it) {
+        (*it)->on_exit(node, status);
+      }
+    }
+  }
+
+  /**
+   * @brief Checks whether the traversal must stop before the next node.
+   *
+   * The traversal is never suspended before some node has completed, so every
+   * tick makes progress however small the budget is.
+   *
+   * @return true if the next node must not be ticked.
+   */
+  bool suspend_requested() const {
+    return clock_ && progressed_ && clock_->now() >= deadline_;
+  }
+
+  /**
+   * @brief Decides whether a node is shed instead of being ticked.
+   *
+   * @param node The node about to be ticked.
+   * @return std::optional<Status> The status the shed node returns, or nothing
+   * if the node must be ticked.
+   */
+  std::optional<Status> shed(const BehaviorNode &node) {
+    return shedder_ ? shed_with_shedder(node) : std::nullopt;
+  }
+
+  /**
+   * @brief Records that a node has completed its tick.
+   */
+  void mark_progress() { progressed_ = true; }
+
+private:
+  /// Ticks the pending interrupt subtrees of interrupts_, if any.
+  void service_interrupts();
+
+  /// Asks shedder_ whether a node is shed.
+  std::optional<Status> shed_with_shedder(const BehaviorNode &node);
+
+  /// The clock used to check the deadline, nullptr if there is no deadline.
+  ClockPtr clock_;
+  /// The time after which no more nodes are ticked.
+  Clock::TimePoint deadline_;
+  /// Whether any node has completed its tick.
+  bool progressed_ = false;
+  /// The load shedder, nullptr if no nodes are shed.
+  LoadShedder *shedder_ = nullptr;
+  /// The observers, nullptr if there are none.
+  const std::vector<TickObserver *> *observers_ = nullptr;
+  /// The interrupt service, nullptr if there are no interrupts.
+  InterruptService *interrupts_ = nullptr;
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "nodes/status.h"
+
+namespace evo::behavior {
+
+class BehaviorNode;
+
+/**
+ * @brief Receives a notification around every node ticked by a BehaviorTree.
+ *
+ * Observers are called on the ticking thread, in the order the nodes are
+ * entered and exited. Nodes skipped by budgets or load shedding are not
+ * reported. Register observers with BehaviorTree::add_observer().
+ */
+class TickObserver {
+public:
+  /**
+   * @brief Virtual destructor for safe polymorphic use.
+   */
+  virtual ~TickObserver() = default;
+
+  /**
+   * @brief Called right before a node is ticked.
+   *
+   * @param node The node about to be ticked.
+   */
+  virtual void on_enter(const BehaviorNode &node) = 0;
+
+  /**
+   * @brief Called right after a node has been ticked.
+   *
+   * @param node The ticked node.
+   * @param status The status the node returned.
+   */
+  virtual void on_exit(const BehaviorNode &node, Status status) = 0;
+};
+
+} // namespace evo::behavior
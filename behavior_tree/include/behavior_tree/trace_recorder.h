@@ -0,0 +1,111 @@
+#pragma once
+
+#include "clock.h"
+#include "tick_observer.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief A tick observer which records a begin and an end event for every
+ * ticked node and exports them as a timeline.
+ *
+ * The timeline is written in the Chrome Trace Event JSON format, which
+ * chrome://tracing and the Perfetto UI open. Each node becomes a span named
+ * after its description, or its type if the description is empty, and the
+ * end event carries the node's type and returned status.
+ *
+ * In ring buffer mode only the latest ticks are kept, so the recorder can stay
+ * attached and the slow tick can be dumped after it happened. Node names and
+ * types are copied when a node is first recorded, so the tree may change or be
+ * freed before the timeline is written.
+ */
+class TraceRecorder : public TickObserver {
+public:
+  /**
+   * @brief Constructs a new TraceRecorder object.
+   *
+   * @param max_ticks The number of latest ticks to keep, 0 to keep all.
+   * @param clock The clock used for timestamps.
+   */
+  explicit TraceRecorder(std::size_t max_ticks = 0,
+                         ClockPtr clock = default_clock());
+
+  /**
+   * @brief Returns the number of recorded ticks, including an unfinished one.
+   *
+   * @return std::size_t The number of ticks.
+   */
+  std::size_t ticks() const;
+
+  /**
+   * @brief Drops all recorded ticks.
+   */
+  void clear();
+
+  /**
+   * @brief Writes the recorded ticks in the Chrome Trace Event JSON format.
+   *
+   * @param out The stream to write to.
+   */
+  void write_chrome_trace(std::ostream &out) const;
+
+  /**
+   * @brief Writes the recorded ticks to a Chrome Trace Event JSON file.
+   *
+   * @param path The path of the file.
+   * @return true If the file was written.
+   */
+  bool write_chrome_trace(const std::string &path) const;
+
+  void on_enter(const BehaviorNode &node) override;
+  void on_exit(const BehaviorNode &node, Status status) override;
+
+private:
+  /// The name and type of a recorded node.
+  struct Label {
+    /// The node's description, or its type if the description is empty.
+    std::string name;
+    /// The node's type.
+    std::string type;
+  };
+
+  /// A begin or end event of a node.
+  struct Event {
+    /// The index of the node's label.
+    std::uint32_t label;
+    /// The time of the event.
+    Clock::TimePoint time;
+    /// Whether the node was entered rather than exited.
+    bool begin;
+    /// The status returned by the node, for end events.
+    Status::State status;
+  };
+
+  /// Starts recording a new tick, reusing the oldest one in ring buffer mode.
+  void start_tick();
+
+  /// Returns the index of the node's label, adding it if it is new.
+  std::uint32_t intern(const BehaviorNode &node);
+
+  /// The number of latest ticks to keep, 0 to keep all.
+  std::size_t max_ticks_;
+  /// The clock used for timestamps.
+  ClockPtr clock_;
+  /// Events of the recorded ticks, oldest first.
+  std::deque<std::vector<Event>> ticks_;
+  /// Labels of the recorded nodes.
+  std::vector<Label> labels_;
+  /// Label indices by node address, checked against the node on every lookup.
+  std::unordered_map<const BehaviorNode *, std::uint32_t> label_index_;
+  /// The nesting depth of the current tick.
+  std::size_t depth_ = 0;
+};
+
+} // namespace evo::behavior
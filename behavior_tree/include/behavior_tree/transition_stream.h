@@ -0,0 +1,199 @@
+#pragma once
+
+#include "clock.h"
+#include "node_index.h"
+#include "nodes/behavior_node.h"
+#include "spsc_queue.h"
+#include "tick_observer.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief A change of the status a node returns.
+ */
+struct TransitionEvent {
+  /// The id of the node, see TransitionSubscription::node().
+  std::uint32_t node = 0;
+  /// The generation of the NodeIndex which gave the id; it changes with the
+  /// tree's root.
+  std::uint64_t generation = 0;
+  /// Whether this is the first status the node returned, from is then
+  /// meaningless.
+  bool initial = false;
+  /// The status the node returned before.
+  Status::State from = Status::FAILURE;
+  /// The status the node returns now.
+  Status::State to = Status::FAILURE;
+  /// The number of the tick, counting from 1.
+  std::uint64_t tick = 0;
+  /// The time the node returned the new status.
+  Clock::TimePoint time;
+};
+
+/**
+ * @brief The labels of a node reported by a TransitionSubscription, copied
+ * when the tree's nodes are numbered.
+ */
+struct TransitionNode {
+  /// The type of the node.
+  std::string type;
+  /// The description of the node.
+  std::string description;
+};
+
+/**
+ * @brief Receives the transitions of the nodes of one subtree.
+ *
+ * The tree pushes events into a lock-free queue during its ticks and the
+ * subscriber pops them from any one thread. When the queue is full, new
+ * events are dropped and counted.
+ */
+class TransitionSubscription {
+public:
+  /**
+   * @brief Constructs a new TransitionSubscription object, see
+   * BehaviorTree::subscribe().
+   *
+   * @param subtree The subtree whose nodes are reported, nullptr for the
+   * whole tree, whichever root it has.
+   * @param capacity The number of events the queue holds.
+   */
+  TransitionSubscription(BehaviorPtr subtree, std::size_t capacity);
+
+  /**
+   * @brief Removes the oldest event.
+   *
+   * @param event Receives the event.
+   * @return true If an event was removed; false if there are none.
+   */
+  bool pop(TransitionEvent &event);
+
+  /**
+   * @brief Returns the number of events dropped because the queue was full.
+   *
+   * @return std::uint64_t The number of dropped events.
+   */
+  std::uint64_t dropped() const;
+
+  /**
+   * @brief Returns the labels of the node an event is about. May be called
+   * from any thread.
+   *
+   * @param event The event.
+   * @return std::optional<TransitionNode> The labels, or nothing if the event
+   * was emitted before the tree's latest set_root().
+   */
+  std::optional<TransitionNode> node(const TransitionEvent &event) const;
+
+private:
+  friend class TransitionTracker;
+
+  /// The labels of the nodes of one numbering of the tree.
+  struct Labels {
+    /// The generation of the NodeIndex which numbered the nodes.
+    std::uint64_t generation = 0;
+    /// The labels by id.
+    std::vector<TransitionNode> nodes;
+  };
+
+  /// The root of the reported subtree, nullptr for the whole tree.
+  BehaviorPtr subtree_;
+  /// Whether each node id belongs to the subtree.
+  std::vector<bool> members_;
+  /// The labels of the tree's nodes, replaced atomically.
+  std::shared_ptr<const Labels> labels_;
+  /// The pending events.
+  SpscQueue<TransitionEvent> queue_;
+  /// The number of dropped events.
+  std::atomic<std::uint64_t> dropped_{0};
+};
+
+/**
+ * @brief A tick observer which detects status transitions and dispatches
+ * them to subscriptions. BehaviorTree installs one on the first subscription.
+ *
+ * Nodes get ids from a NodeIndex, and the previous status of each node is kept
+ * in an array indexed by id, so detection is a compare per visited node.
+ */
+class TransitionTracker : public TickObserver {
+public:
+  /**
+   * @brief Constructs a new TransitionTracker object.
+   *
+   * @param clock The clock used for timestamps.
+   */
+  explicit TransitionTracker(ClockPtr clock);
+
+  /**
+   * @brief Numbers the nodes of a new tree and forgets previous statuses.
+   *
+   * @param root The root node of the tree.
+   */
+  void set_root(const BehaviorPtr &root);
+
+  /**
+   * @brief Tracks a tree numbered by an index shared with other observers and
+   * forgets previous statuses.
+   *
+   * @param index The index of the tree's nodes.
+   */
+  void set_index(std::shared_ptr<const NodeIndex> index);
+
+  /**
+   * @brief Sets the clock used for timestamps.
+   *
+   * @param clock The clock.
+   */
+  void set_clock(ClockPtr clock);
+
+  /**
+   * @brief Starts reporting the transitions of a subtree.
+   *
+   * @param subscription The subscription.
+   */
+  void add(const std::shared_ptr<TransitionSubscription> &subscription);
+
+  /**
+   * @brief Stops reporting to a subscription.
+   *
+   * @param subscription The subscription.
+   */
+  void remove(const std::shared_ptr<TransitionSubscription> &subscription);
+
+  /**
+   * @brief Tells whether there are subscriptions.
+   *
+   * @return true If no subscription is left.
+   */
+  bool empty() const;
+
+  void on_enter(const BehaviorNode &node) override;
+  void on_exit(const BehaviorNode &node, Status status) override;
+
+private:
+  /// Marks the nodes of a subscription's subtree.
+  void update_members(TransitionSubscription &subscription) const;
+
+  /// The clock used for timestamps.
+  ClockPtr clock_;
+  /// Ids of the nodes.
+  std::shared_ptr<const NodeIndex> index_;
+  /// The labels of the nodes.
+  std::shared_ptr<const TransitionSubscription::Labels> labels_;
+  /// The previous status of each node, or never_ticked.
+  std::vector<std::uint8_t> previous_;
+  /// The subscriptions.
+  std::vector<std::shared_ptr<TransitionSubscription>> subscriptions_;
+  /// The nesting depth of the current tick.
+  std::size_t depth_ = 0;
+  /// The number of the current tick.
+  std::uint64_t tick_ = 0;
+};
+
+} // namespace evo::behavior
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "behavior_tree.h"
+#include "clock.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace evo::behavior {
+
+/**
+ * @brief Scheduling statistics of a tree hosted by a TreeExecutor.
+ */
+struct TreeStats {
+  /// The number of completed ticks.
+  std::uint64_t ticks = 0;
+  /// The number of ticks which completed after their deadline.
+  std::uint64_t deadline_misses = 0;
+  /// The number of releases dropped because the tree fell more than a period
+  /// behind.
+  std::uint64_t skipped_releases = 0;
+  /// The number of ticks which threw an exception; they count as failures.
+  std::uint64_t exceptions = 0;
+  /// The longest time between the release of a tick and its start.
+  Clock::Duration max_start_delay{0};
+  /// The sum of the start delays.
+  Clock::Duration total_start_delay{0};
+  /// The largest lateness, the completion time minus the deadline. Negative
+  /// when every tick completed early.
+  Clock::Duration max_lateness = Clock::Duration::min();
+  /// The sum of the latenesses.
+  Clock::Duration total_lateness{0};
+  /// The status of the last tick.
+  Status last_status = Status::Failure;
+
+  /**
+   * @brief Returns the mean lateness of the ticks.
+   *
+   * @return Clock::Duration The mean lateness, zero before the first tick.
+   */
+  Clock::Duration mean_lateness() const {
+    return ticks ? total_lateness / static_cast<Clock::Duration::rep>(ticks)
+                 : Clock::Duration::zero();
+  }
+};
+
+/**
+ * @brief Ticks many trees periodically on a fixed set of worker threads.
+ *
+ * Every tree is released once per period and its tick must complete within a
+ * relative deadline. Released ticks are queued per worker ordered by absolute
+ * deadline, earliest first; a worker without ticks of its own steals the most
+ * urgent tick of another worker. A tree is never ticked concurrently with
+ * itself: its next release is only scheduled when its tick has completed.
+ * When a tree falls more than a period behind, the missed releases are
+ * skipped instead of being ticked in a burst.
+ */
+class TreeExecutor {
+public:
+  /// Identifies a hosted tree.
+  using TreeId = std::uint64_t;
+
+  /**
+   * @brief Starts the worker threads.
+   *
+   * @param workers The number of worker threads; zero counts as one.
+   * @param clock The clock used for releases, deadlines and statistics. The
+   * workers sleep in real time, so it must advance like a steady clock; it
+   * does not follow default_clock(), which may be simulated.
+   */
+  explicit TreeExecutor(
+      std::size_t workers = std::thread::hardware_concurrency(),
+      ClockPtr clock = std::make_shared<SteadyClock>());
+
+  TreeExecutor(const TreeExecutor &) = delete;
+  TreeExecutor &operator=(const TreeExecutor &) = delete;
+
+  /**
+   * @brief Stops the worker threads after their current ticks.
+   */
+  ~TreeExecutor();
+
+  /**
+   * @brief Hosts a tree, which is released for the first time immediately.
+   *
+   * @param tree The tree.
+   * @param period The time between releases.
+   * @param deadline The time after each release by which the tick should be
+   * complete; zero for the period.
+   * @return TreeId The id of the tree.
+   */
+  TreeId add(std::shared_ptr<BehaviorTree> tree, Clock::Duration period,
+             Clock::Duration deadline = Clock::Duration::zero());
+
+  /**
+   * @brief Stops ticking a tree. A tick in progress completes.
+   *
+   * @param id The id of the tree.
+   */
+  void remove(TreeId id);
+
+  /**
+   * @brief Returns the scheduling statistics of a tree.
+   *
+   * @param id The id of the tree.
+   * @return TreeStats The statistics.
+   * @throws std::out_of_range If the tree is not hosted.
+   */
+  TreeStats stats(TreeId id) const;
+
+  /**
+   * @brief Returns the number of worker threads.
+   *
+   * @return std::size_t The number of worker threads.
+   */
+  std::size_t size() const;
+
+private:
+  /// A hosted tree.
+  struct Entry {
+    std::shared_ptr<BehaviorTree> tree;
+    Clock::Duration period;
+    Clock::Duration deadline;
+    /// Set by remove().
+    std::atomic<bool> removed{false};
+    /// Protects stats.
+    mutable std::mutex stats_mutex;
+    TreeStats stats;
+  };
+
+  /// A release of a tree.
+  struct Job {
+    Clock::TimePoint release;
+    Clock::TimePoint deadline;
+    std::shared_ptr<Entry> entry;
+  };
+
+  /// The ticks released to one worker, a heap ordered by deadline.
+  struct Queue {
+    std::mutex mutex;
+    std::vector<Job> jobs;
+  };
+
+  /// Orders heaps of jobs by release time, earliest on top.
+  static bool later_release(const Job &a, const Job &b);
+
+  /// Orders heaps of jobs by deadline, earliest on top.
+  static bool later_deadline(const Job &a, const Job &b);
+
+  /// Releases due jobs, runs ticks and sleeps until the next release.
+  void work(std::size_t worker);
+
+  /// Moves the due jobs into a worker's queue. Requires mutex_.
+  void release(std::size_t worker, Clock::TimePoint now);
+
+  /// Takes the most urgent job of a worker's queue, or steals one.
+  bool take(std::size_t worker, Job &job);
+
+  /// Ticks a tree and schedules its next release.
+  void run(const Job &job);
+
+  /// The clock used for releases, deadlines and statistics.
+  ClockPtr clock_;
+  /// The queues of the workers.
+  std::vector<std::unique_ptr<Queue>> queues_;
+  /// The worker threads.
+  std::vector<std::thread> workers_;
+  /// Protects timers_, entries_ and next_id_, and is held when workers decide
+  /// to sleep.
+  mutable std::mutex mutex_;
+  /// Signals new releases or shutdown to sleeping workers.
+  std::condition_variable wake_;
+  /// The pending releases, a heap ordered by release time.
+  std::vector<Job> timers_;
+  /// The hosted trees.
+  std::unordered_map<TreeId, std::shared_ptr<Entry>> entries_;
+  /// The id of the next tree.
+  TreeId next_id_ = 0;
+  /// The number of released jobs waiting in queues.
+  std::atomic<std::size_t> ready_{0};
+  /// Tells the workers to exit.
+  bool stopping_ = false;
+};
+
+} // namespace evo::behavior
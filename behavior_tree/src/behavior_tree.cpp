@@ -1,19 +1,293 @@
 #include "behavior_tree/behavior_tree.h" // Include the BehaviorTree class declaration
 #include "behavior_tree/nodes/behavior_node.h" // Ensure correct path to the behavior node header
 #include "behavior_tree/nodes/status.h" // Include the Status class for handling node statuses
+#include "behavior_tree/tick_control.h"
+#include <algorithm>
 #include <memory>
+#include <unordered_set>
 
 namespace evo::behavior {
 
 BehaviorTree::BehaviorTree(BehaviorPtr root) : root_(root) {}
 
-void BehaviorTree::set_root(BehaviorPtr root) { root_ = root; }
+void BehaviorTree::set_root(BehaviorPtr root) {
+  root_ = root;
+  node_index_.reset();
+  if (prefetch_pool_) {
+    collect_prefetchable();
+  }
+  if (transitions_) {
+    transitions_->set_index(node_index());
+  }
+  if (metrics_) {
+    metrics_->set_index(node_index());
+  }
+}
+
+void BehaviorTree::set_clock(ClockPtr clock) {
+  clock_ = std::move(clock);
+  if (transitions_) {
+    transitions_->set_clock(clock_);
+  }
+  if (metrics_) {
+    metrics_->set_clock(clock_);
+  }
+}
+
+void BehaviorTree::set_user_data(std::any user_data) {
+  user_data_ = std::move(user_data);
+}
+
+const TickContext &BehaviorTree::context() const { return context_; }
+
+void BehaviorTree::set_load_shedding(const LoadSheddingPolicy &policy) {
+  shedder_.emplace(policy);
+}
+
+void BehaviorTree::disable_load_shedding() { shedder_.reset(); }
+
+const LoadShedder *BehaviorTree::load_shedder() const {
+  return shedder_ ? &*shedder_ : nullptr;
+}
+
+void BehaviorTree::set_prefetching(std::shared_ptr<ThreadPool> pool,
+                                   std::function<void()> snapshot) {
+  prefetch_pool_ = std::move(pool);
+  snapshot_ = std::move(snapshot);
+  collect_prefetchable();
+}
+
+void BehaviorTree::disable_prefetching() {
+  prefetch_pool_.reset();
+  snapshot_ = nullptr;
+  prefetchable_.clear();
+}
+
+std::shared_ptr<const NodeIndex> BehaviorTree::node_index() {
+  if (!node_index_) {
+    node_index_ = std::make_shared<NodeIndex>(root_);
+  }
+  return node_index_;
+}
+
+void BehaviorTree::add_observer(std::shared_ptr<TickObserver> observer) {
+  observer_ptrs_.push_back(observer.get());
+  observers_.push_back(std::move(observer));
+}
+
+void BehaviorTree::remove_observer(
+    const std::shared_ptr<TickObserver> &observer) {
+  observers_.erase(std::remove(observers_.begin(), observers_.end(), observer),
+                   observers_.end());
+  observer_ptrs_.erase(std::remove(observer_ptrs_.begin(),
+                                   observer_ptrs_.end(), observer.get()),
+                       observer_ptrs_.end());
+}
+
+std::shared_ptr<TransitionSubscription>
+BehaviorTree::subscribe(BehaviorPtr subtree, std::size_t capacity) {
+  auto subscription =
+      std::make_shared<TransitionSubscription>(std::move(subtree), capacity);
+  if (!transitions_) {
+    transitions_ = std::make_shared<TransitionTracker>(clock_);
+    transitions_->set_index(node_index());
+    add_observer(transitions_);
+  }
+  transitions_->add(subscription);
+  return subscription;
+}
+
+void BehaviorTree::unsubscribe(
+    const std::shared_ptr<TransitionSubscription> &subscription) {
+  if (!transitions_) {
+    return;
+  }
+  transitions_->remove(subscription);
+  if (transitions_->empty()) {
+    remove_observer(transitions_);
+    transitions_.reset();
+  }
+}
+
+std::shared_ptr<TreeMetrics>
+BehaviorTree::enable_metrics(const std::string &name,
+                             MetricsRegistry &registry) {
+  disable_metrics();
+  metrics_ = std::make_shared<TreeMetrics>(name, clock_);
+  metrics_->set_index(node_index());
+  metrics_registry_ = &registry;
+  registry.add(metrics_);
+  add_observer(metrics_);
+  return metrics_;
+}
+
+void BehaviorTree::disable_metrics() {
+  if (!metrics_) {
+    return;
+  }
+  remove_observer(metrics_);
+  metrics_registry_->remove(metrics_.get());
+  metrics_.reset();
+  metrics_registry_ = nullptr;
+}
+
+std::shared_ptr<Interrupt>
+BehaviorTree::add_interrupt(BehaviorPtr subtree,
+                            const InterruptPolicy &policy) {
+  return interrupts_->add(std::move(subtree), policy, clock_);
+}
+
+void BehaviorTree::remove_interrupt(
+    const std::shared_ptr<Interrupt> &interrupt) {
+  interrupts_->remove(interrupt);
+}
+
+bool BehaviorTree::set_interrupt_thread_priority(int priority) {
+  return interrupts_->set_thread_priority(priority);
+}
+
+bool BehaviorTree::set_real_time(const RealTimePolicy &policy) {
+  real_time_ = policy;
+  if (root_) {
+    std::unordered_set<const BehaviorNode *> visited;
+    std::vector<BehaviorPtr> pending{root_};
+    while (!pending.empty()) {
+      auto node = pending.back();
+      pending.pop_back();
+      if (!visited.insert(node.get()).second) {
+        continue;
+      }
+      // Children may be created by their parent's preallocation
+      node->preallocate();
+      pending.insert(pending.end(), node->children().begin(),
+                     node->children().end());
+    }
+  }
+  // The library's counters are created on first use
+  library_metrics();
+  context_.scratch().reserve(policy.scratch_bytes);
+  return prepare_real_time_memory(policy);
+}
+
+void BehaviorTree::disable_real_time() { real_time_.reset(); }
+
+std::uint64_t BehaviorTree::tick_allocations() const {
+  return tick_allocations_;
+}
+
+void BehaviorTree::collect_prefetchable() {
+  prefetchable_.clear();
+  if (!root_) {
+    return;
+  }
+  std::unordered_set<const BehaviorNode *> visited;
+  std::vector<BehaviorPtr> pending{root_};
+  while (!pending.empty()) {
+    auto node = pending.back();
+    pending.pop_back();
+    if (!visited.insert(node.get()).second) {
+      continue;
+    }
+    auto condition = std::dynamic_pointer_cast<Condition>(node);
+    if (condition && condition->prefetchable()) {
+      prefetchable_.push_back(condition);
+    }
+    pending.insert(pending.end(), node->children().begin(),
+                   node->children().end());
+  }
+}
+
+Status BehaviorTree::tick_observed() {
+  auto *control = TickControl::current();
+  if (!control) {
+    return (*root_)();
+  }
+  control->enter(*root_);
+  Status result = (*root_)();
+  control->exit(*root_, result);
+  return result;
+}
+
+Status BehaviorTree::tick_root() {
+  if (!prefetch_pool_) {
+    return tick_observed();
+  }
+  if (snapshot_) {
+    snapshot_();
+  }
+  prefetch_pool_->parallel_for(prefetchable_.size(), [this](std::size_t i) {
+    auto context = context_.branch();
+    TickContext::Scope scope(&context);
+    prefetchable_[i]->prefetch();
+  });
+  Status result = tick_observed();
+  for (auto &condition : prefetchable_) {
+    condition->discard_prefetched();
+  }
+  return result;
+}
 
 Status BehaviorTree::run() {
   if (!root_) {
     return Status::Failure; // Return failure if there is no root node set
   }
-  return (*root_)(); // Execute the root node and return its status
+  return tick(std::nullopt); // Execute the root node and return its status
+}
+
+Status BehaviorTree::run(Clock::Duration budget) {
+  if (!root_) {
+    return Status::Failure; // Return failure if there is no root node set
+  }
+  return tick(clock_->now() + budget);
+}
+
+Status BehaviorTree::tick(std::optional<Clock::TimePoint> deadline) {
+  // Always lock, so interrupts added from other threads wait for the tick
+  std::lock_guard<std::mutex> interrupt_lock(interrupts_->tick_mutex());
+  auto *interrupts = interrupts_->empty() ? nullptr : interrupts_.get();
+  // Set the clock and the user data on every tick, as the tree may have moved
+  context_.set_clock(clock_.get());
+  context_.set_user_data(&user_data_);
+  context_.begin();
+  TickContext::Scope context_scope(&context_);
+  std::optional<AllocationGuard> guard;
+  if (real_time_) {
+    guard.emplace(real_time_->on_allocation);
+  }
+  Status result = tick_controlled(deadline, interrupts);
+  context_.end();
+  if (guard) {
+    tick_allocations_ += guard->allocations();
+  }
+  return result;
+}
+
+Status BehaviorTree::tick_controlled(std::optional<Clock::TimePoint> deadline,
+                                     InterruptService *interrupts) {
+  if (!deadline && !shedder_ && observers_.empty() && !interrupts) {
+    // Do not inherit the control of an enclosing tick
+    TickControl::Scope scope(nullptr);
+    return tick_root();
+  }
+
+  auto start = context_.now();
+  TickControl control;
+  if (deadline) {
+    control.set_deadline(clock_, *deadline);
+  }
+  if (shedder_ && shedder_->active()) {
+    control.set_load_shedder(&*shedder_);
+  }
+  control.set_observers(&observer_ptrs_);
+  control.set_interrupts(interrupts);
+  Status result = [&] {
+    TickControl::Scope scope(&control);
+    return tick_root();
+  }();
+  if (shedder_) {
+    shedder_->record_tick(clock_->now() - start);
+  }
+  return result;
 }
 
-} // namespace evo::behavior
\ No newline at end of file
+} // namespace evo::behavior
@@ -0,0 +1,98 @@
+#include "behavior_tree/clock.h"
+#include <stdexcept>
+
+namespace evo::behavior {
+
+namespace {
+
+/// The steady clock shared by default.
+const ClockPtr &steady_clock() {
+  static const ClockPtr clock = std::make_shared<SteadyClock>();
+  return clock;
+}
+
+/// The clock returned by default_clock().
+ClockPtr &current_default_clock() {
+  static ClockPtr clock = steady_clock();
+  return clock;
+}
+
+} // namespace
+
+void Clock::add_deadline(TimePoint) {}
+
+Clock::TimePoint SteadyClock::now() const {
+  return std::chrono::steady_clock::now();
+}
+
+SimulatedClock::SimulatedClock(TimePoint start)
+    : now_(start.time_since_epoch().count()) {}
+
+Clock::TimePoint SimulatedClock::now() const {
+  return TimePoint(Duration(now_.load(std::memory_order_acquire)));
+}
+
+void SimulatedClock::add_deadline(TimePoint deadline) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (deadline > now()) {
+    deadlines_.push(deadline);
+  }
+}
+
+void SimulatedClock::advance(Duration step) {
+  if (step < Duration::zero()) {
+    throw std::invalid_argument("SimulatedClock cannot move backwards");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto time = now() + step;
+  now_.store(time.time_since_epoch().count(), std::memory_order_release);
+  drop_deadlines(time);
+}
+
+void SimulatedClock::advance_to(TimePoint time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (time < now()) {
+    throw std::invalid_argument("SimulatedClock cannot move backwards");
+  }
+  now_.store(time.time_since_epoch().count(), std::memory_order_release);
+  drop_deadlines(time);
+}
+
+std::optional<Clock::TimePoint> SimulatedClock::next_deadline() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  drop_deadlines(now());
+  if (deadlines_.empty()) {
+    return std::nullopt;
+  }
+  return deadlines_.top();
+}
+
+bool SimulatedClock::advance_to_next_deadline(TimePoint limit) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto time = now();
+  drop_deadlines(time);
+  bool reached = !deadlines_.empty() && deadlines_.top() <= limit;
+  auto target = reached ? deadlines_.top() : limit;
+  if (target > time) {
+    now_.store(target.time_since_epoch().count(), std::memory_order_release);
+    drop_deadlines(target);
+  }
+  return reached;
+}
+
+void SimulatedClock::drop_deadlines(TimePoint time) const {
+  while (!deadlines_.empty() && deadlines_.top() <= time) {
+    deadlines_.pop();
+  }
+}
+
+ClockPtr default_clock() {
+  return std::atomic_load(&current_default_clock());
+}
+
+void set_default_clock(ClockPtr clock) {
+  std::atomic_store(&current_default_clock(),
+                    clock ? std::move(clock) : steady_clock());
+}
+
+} // namespace evo::behavior
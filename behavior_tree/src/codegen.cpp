@@ -0,0 +1,446 @@
+#include "behavior_tree/codegen.h"
+#include "behavior_tree/bt_factory.h"
+#include <cctype>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace evo::behavior::bt_codegen {
+
+namespace {
+
+/// The kinds of nodes the generator knows.
+enum class Kind {
+  SEQUENCE,
+  FALLBACK,
+  SEQUENCE_MEMORY,
+  FALLBACK_MEMORY,
+  PARALLEL,
+  SKIPPER,
+  LATCH,
+  NOT,
+  TRY_ELSE,
+  IF_THEN,
+  IF_THEN_ELSE,
+  ACTION,
+  UNLATCH,
+  LEAF
+};
+
+/// Returns the kind of a node; derived classes are leaves because they may
+/// override operator().
+Kind kind_of(const BehaviorNode &node) {
+  const auto &type = typeid(node);
+  if (type == typeid(Sequence)) {
+    return Kind::SEQUENCE;
+  }
+  if (type == typeid(Fallback)) {
+    return Kind::FALLBACK;
+  }
+  if (type == typeid(SequenceMemory)) {
+    return Kind::SEQUENCE_MEMORY;
+  }
+  if (type == typeid(FallbackMemory)) {
+    return Kind::FALLBACK_MEMORY;
+  }
+  if (type == typeid(Parallel)) {
+    return Kind::PARALLEL;
+  }
+  if (type == typeid(Skipper)) {
+    return Kind::SKIPPER;
+  }
+  if (type == typeid(Latch)) {
+    return Kind::LATCH;
+  }
+  if (type == typeid(Not)) {
+    return Kind::NOT;
+  }
+  if (type == typeid(TryElse)) {
+    return Kind::TRY_ELSE;
+  }
+  if (type == typeid(IfThen)) {
+    return Kind::IF_THEN;
+  }
+  if (type == typeid(IfThenElse)) {
+    return Kind::IF_THEN_ELSE;
+  }
+  if (type == typeid(Action)) {
+    return Kind::ACTION;
+  }
+  if (type == typeid(Unlatch)) {
+    return Kind::UNLATCH;
+  }
+  return Kind::LEAF;
+}
+
+/// Turns a description into a C++ identifier, e.g. "Check Battery" into
+/// "check_battery".
+std::string identifier_of(const std::string &text) {
+  std::string identifier;
+  for (char c : text) {
+    if (std::isalnum(static_cast<unsigned char>(c))) {
+      identifier +=
+          static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    } else if (!identifier.empty() && identifier.back() != '_') {
+      identifier += '_';
+    }
+  }
+  while (!identifier.empty() && identifier.back() == '_') {
+    identifier.pop_back();
+  }
+  if (!identifier.empty() &&
+      std::isdigit(static_cast<unsigned char>(identifier.front()))) {
+    identifier = "leaf_" + identifier;
+  }
+  return identifier;
+}
+
+/// Escapes a string for a C++ comment.
+std::string comment_of(const BehaviorNode &node) {
+  std::string comment = node.type();
+  if (!node.description().empty()) {
+    comment += " \"";
+    for (char c : node.description()) {
+      comment += c == '\n' ? ' ' : c;
+    }
+    comment += "\"";
+  }
+  return comment;
+}
+
+/// Generates the code of one tree.
+class Generator {
+public:
+  Generator(const BehaviorPtr &root, const Options &options)
+      : options_(options) {
+    if (!root) {
+      throw std::invalid_argument("bt_codegen requires a root node");
+    }
+    index(root);
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+      // Unlatch nodes only call a leaf function if their latch is elsewhere
+      if (kinds_[i] == Kind::ACTION || kinds_[i] == Kind::LEAF ||
+          (kinds_[i] == Kind::UNLATCH && latch_of(i) == indices_.end())) {
+        add_symbol(i);
+      }
+    }
+  }
+
+  std::string header() {
+    std::ostringstream body;
+    emit(0, "result", 1, body);
+
+    const auto &name = options_.name;
+    std::ostringstream out;
+    out << "// Generated by bt_codegen. Do not edit.\n"
+        << "#pragma once\n\n"
+        << "#include <behavior_tree/nodes/behavior_node.h>\n"
+        << "#include <behavior_tree/nodes/status.h>\n"
+        << "#include <cstdint>\n"
+        << "#include <sstream>\n"
+        << "#include <string>\n\n"
+        << "namespace " << options_.name_space << " {\n\n";
+
+    out << "/// State of the memory and latch nodes ticked by " << name
+        << "().\n"
+        << "struct " << name << "_state {\n";
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+      auto kind = kinds_[i];
+      if (kind == Kind::SEQUENCE_MEMORY || kind == Kind::FALLBACK_MEMORY) {
+        out << "  /// " << comment_of(*nodes_[i]) << "\n"
+            << "  std::uint32_t n" << i << "_current = 0;\n";
+      } else if (kind == Kind::LATCH) {
+        out << "  /// " << comment_of(*nodes_[i]) << "\n"
+            << "  bool n" << i << "_latched = false;\n"
+            << "  evo::behavior::Status::State n" << i
+            << "_result = evo::behavior::Status::FAILURE;\n";
+      }
+    }
+    out << "};\n\n";
+
+    out << "/**\n"
+        << " * Ticks the tree. Leaves must provide:\n";
+    for (const auto &[symbol, is_action] : symbols_) {
+      out << " *   " << (is_action ? "void " : "evo::behavior::Status ")
+          << symbol << "();\n";
+    }
+    out << " */\n"
+        << "template <class Leaves>\n"
+        << "evo::behavior::Status " << name << "(" << name
+        << "_state &state, Leaves &leaves) {\n"
+        << "  using evo::behavior::Status;\n"
+        << "  (void)state;\n"
+        << "  Status result = Status::Failure;\n"
+        << body.str() << "  return result;\n"
+        << "}\n\n";
+
+    out << "/**\n"
+        << " * Ticks fixture.source and " << name
+        << "() side by side and returns a description of\n"
+        << " * the first tick at which their statuses differ, or an empty "
+           "string.\n"
+        << " */\n"
+        << "template <class Fixture>\n"
+        << "std::string " << name << "_check(Fixture &fixture, int ticks) {\n"
+        << "  " << name << "_state state;\n"
+        << "  for (int tick = 0; tick < ticks; ++tick) {\n"
+        << "    fixture.prepare(tick);\n"
+        << "    evo::behavior::Status expected = (*fixture.source)();\n"
+        << "    evo::behavior::Status actual = " << name
+        << "(state, fixture.leaves);\n"
+        << "    if (expected != actual) {\n"
+        << "      std::ostringstream mismatch;\n"
+        << "      mismatch << \"tick \" << tick << \": expected \" << expected\n"
+        << "               << \", got \" << actual;\n"
+        << "      return mismatch.str();\n"
+        << "    }\n"
+        << "  }\n"
+        << "  return {};\n"
+        << "}\n\n"
+        << "} // namespace " << options_.name_space << "\n";
+    return out.str();
+  }
+
+private:
+  /// Numbers the nodes in depth-first order and collects leaf symbols.
+  std::size_t index(const BehaviorPtr &node) {
+    auto indexed = indices_.find(node.get());
+    if (indexed != indices_.end()) {
+      return indexed->second;
+    }
+    auto index = nodes_.size();
+    indices_.emplace(node.get(), index);
+    nodes_.push_back(node);
+    kinds_.push_back(kind_of(*node));
+    children_.emplace_back();
+
+    auto kind = kinds_[index];
+    if (kind == Kind::ACTION || kind == Kind::LEAF || kind == Kind::UNLATCH) {
+      return index;
+    }
+    for (const auto &child : node->children()) {
+      auto child_index = this->index(child);
+      children_[index].push_back(child_index);
+    }
+    return index;
+  }
+
+  /// Assigns the Leaves member function which implements a leaf node.
+  void add_symbol(std::size_t index) {
+    const auto &node = *nodes_[index];
+    auto symbol = options_.leaf_symbol ? options_.leaf_symbol(node)
+                                       : identifier_of(node.description());
+    if (symbol.empty()) {
+      symbol = node.type() + "_" + std::to_string(index);
+    }
+    bool is_action = kinds_[index] != Kind::LEAF;
+    auto [known, inserted] = symbols_.emplace(symbol, is_action);
+    if (!inserted && known->second != is_action) {
+      throw std::invalid_argument("Leaf function '" + symbol +
+                                  "' is used by an action and a condition");
+    }
+    leaf_symbols_.emplace(index, symbol);
+  }
+
+  /// Finds the latch released by an unlatch node among the tree's nodes.
+  std::unordered_map<const BehaviorNode *, std::size_t>::const_iterator
+  latch_of(std::size_t index) const {
+    return indices_.find(&static_cast<const Unlatch &>(*nodes_[index]).latch());
+  }
+
+  /// Appends statements resetting the memory nodes of a subtree.
+  void emit_reset(std::size_t index, const std::string &indent,
+                  std::vector<bool> &visited, std::ostream &out) const {
+    if (visited[index]) {
+      return;
+    }
+    visited[index] = true;
+    auto kind = kinds_[index];
+    if (kind == Kind::SEQUENCE_MEMORY || kind == Kind::FALLBACK_MEMORY) {
+      out << indent << "state.n" << index << "_current = 0;\n";
+    }
+    for (auto child : children_[index]) {
+      emit_reset(child, indent, visited, out);
+    }
+  }
+
+  /// Appends statements which tick a node and assign its status to target.
+  void emit(std::size_t index, const std::string &target, int depth,
+            std::ostream &out) {
+    std::string indent(2 * depth, ' ');
+    std::string inner(2 * (depth + 1), ' ');
+    const auto &children = children_[index];
+    auto kind = kinds_[index];
+    auto n = "n" + std::to_string(index);
+
+    out << indent << "// " << comment_of(*nodes_[index]) << "\n";
+    switch (kind) {
+    case Kind::SEQUENCE:
+    case Kind::FALLBACK:
+    case Kind::SKIPPER: {
+      const char *pass = kind == Kind::SEQUENCE   ? "Status::Success"
+                         : kind == Kind::FALLBACK ? "Status::Failure"
+                                                  : "Status::Running";
+      out << indent << target << " = " << pass << ";\n";
+      for (auto child : children) {
+        out << indent << "if (" << target << " == " << pass << ") {\n";
+        emit(child, target, depth + 1, out);
+        out << indent << "}\n";
+      }
+      break;
+    }
+
+    case Kind::SEQUENCE_MEMORY:
+    case Kind::FALLBACK_MEMORY: {
+      const char *pass = kind == Kind::SEQUENCE_MEMORY ? "Status::Success"
+                                                       : "Status::Failure";
+      out << indent << target << " = " << pass << ";\n";
+      for (std::size_t i = 0; i < children.size(); ++i) {
+        out << indent << "if (" << target << " == " << pass << " && state."
+            << n << "_current <= " << i << ") {\n";
+        emit(children[i], target, depth + 1, out);
+        out << inner << "if (" << target << " == " << pass << ") {\n"
+            << inner << "  state." << n << "_current = " << i + 1 << ";\n"
+            << inner << "}\n"
+            << indent << "}\n";
+      }
+      out << indent << "if (" << target << " == " << pass << ") {\n";
+      std::vector<bool> visited(nodes_.size(), false);
+      emit_reset(index, inner, visited, out);
+      out << indent << "}\n";
+      break;
+    }
+
+    case Kind::PARALLEL: {
+      auto var = "r" + std::to_string(next_var_++);
+      out << indent << "bool " << var << "_running = false;\n"
+          << indent << "bool " << var << "_failed = false;\n";
+      for (auto child : children) {
+        out << indent << "if (!" << var << "_running) {\n";
+        emit(child, target, depth + 1, out);
+        out << inner << var << "_running = " << target
+            << " == Status::Running;\n"
+            << inner << var << "_failed = " << var << "_failed || " << target
+            << " == Status::Failure;\n"
+            << indent << "}\n";
+      }
+      out << indent << target << " = " << var
+          << "_running ? Status::Running\n"
+          << indent << "    : " << var
+          << "_failed ? Status::Failure : Status::Success;\n";
+      break;
+    }
+
+    case Kind::LATCH:
+      out << indent << "if (!state." << n << "_latched) {\n";
+      emit(children[0], target, depth + 1, out);
+      out << inner << "state." << n << "_result = " << target << ";\n"
+          << inner << "state." << n << "_latched = true;\n"
+          << indent << "}\n"
+          << indent << target << " = state." << n << "_result;\n";
+      break;
+
+    case Kind::NOT:
+      emit(children[0], target, depth, out);
+      out << indent << "if (" << target << " != Status::Running) {\n"
+          << inner << target << " = " << target
+          << " == Status::Success ? Status::Failure : Status::Success;\n"
+          << indent << "}\n";
+      break;
+
+    case Kind::TRY_ELSE:
+      emit(children[0], target, depth, out);
+      out << indent << "if (" << target << " == Status::Failure) {\n";
+      emit(children[1], target, depth + 1, out);
+      out << indent << "}\n";
+      break;
+
+    case Kind::IF_THEN:
+    case Kind::IF_THEN_ELSE:
+      emit(children[0], target, depth, out);
+      out << indent << "if (" << target << " == Status::Success) {\n";
+      emit(children[1], target, depth + 1, out);
+      if (kind == Kind::IF_THEN) {
+        out << indent << "} else if (" << target << " == Status::Failure) {\n"
+            << inner << target << " = Status::Success;\n";
+      } else {
+        out << indent << "} else if (" << target << " == Status::Failure) {\n";
+        emit(children[2], target, depth + 1, out);
+      }
+      out << indent << "}\n";
+      break;
+
+    case Kind::UNLATCH:
+      if (auto latch = latch_of(index); latch != indices_.end()) {
+        out << indent << "state.n" << latch->second << "_latched = false;\n"
+            << indent << target << " = Status::Success;\n";
+        break;
+      }
+      // The latch is not part of the tree, call the action
+      [[fallthrough]];
+
+    case Kind::ACTION:
+      out << indent << "try {\n"
+          << inner << "leaves." << leaf_symbols_.at(index) << "();\n"
+          << inner << target << " = Status::Success;\n"
+          << indent << "} catch (...) {\n"
+          << inner << target << " = Status::Failure;\n"
+          << indent << "}\n";
+      break;
+
+    case Kind::LEAF:
+      out << indent << "try {\n"
+          << inner << target << " = leaves." << leaf_symbols_.at(index)
+          << "();\n"
+          << indent << "} catch (...) {\n"
+          << inner << target << " = Status::Failure;\n"
+          << indent << "}\n";
+      break;
+    }
+  }
+
+  /// Settings of code generation.
+  const Options &options_;
+  /// Nodes in depth-first order.
+  std::vector<BehaviorPtr> nodes_;
+  /// Kinds of the nodes.
+  std::vector<Kind> kinds_;
+  /// Child indices of the nodes, empty for leaves.
+  std::vector<std::vector<std::size_t>> children_;
+  /// Indices of the nodes.
+  std::unordered_map<const BehaviorNode *, std::size_t> indices_;
+  /// Leaf function names by node index.
+  std::unordered_map<std::size_t, std::string> leaf_symbols_;
+  /// Leaf function names, mapped to whether they implement actions.
+  std::map<std::string, bool> symbols_;
+  /// Counter for unique names of local variables.
+  std::size_t next_var_ = 0;
+};
+
+} // namespace
+
+std::string generate(const BehaviorPtr &root, const Options &options) {
+  return Generator(root, options).header();
+}
+
+std::string generate_test(const std::string &header,
+                          const std::string &fixture_header,
+                          const std::string &fixture, const Options &options,
+                          int ticks) {
+  std::ostringstream out;
+  out << "// Generated by bt_codegen. Do not edit.\n"
+      << "#include \"" << header << "\"\n"
+      << "#include \"" << fixture_header << "\"\n"
+      << "#include <gtest/gtest.h>\n\n"
+      << "TEST(GeneratedTreeTest, " << options.name << ") {\n"
+      << "  " << fixture << " fixture;\n"
+      << "  auto mismatch = " << options.name_space << "::" << options.name
+      << "_check(fixture, " << ticks << ");\n"
+      << "  ASSERT_TRUE(mismatch.empty()) << mismatch;\n"
+      << "}\n";
+  return out.str();
+}
+
+} // namespace evo::behavior::bt_codegen
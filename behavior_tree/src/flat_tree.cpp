@@ -0,0 +1,292 @@
+#include "behavior_tree/flat_tree.h"
+#include "behavior_tree/bt_factory.h"
+#include "behavior_tree/metrics.h"
+#include <stdexcept>
+#include <typeindex>
+
+namespace evo::behavior {
+
+FlatTree::FlatTree(const BehaviorPtr &root) {
+  if (!root) {
+    throw std::invalid_argument("FlatTree requires a root node");
+  }
+  auto layout = std::make_shared<Layout>();
+  std::unordered_map<const BehaviorNode *, std::uint32_t> indices;
+  add(*layout, root, indices);
+  for (auto &node : layout->nodes) {
+    if (node.kind == Kind::UNLATCH) {
+      auto latch = indices.find(&static_cast<Unlatch *>(node.source)->latch());
+      node.target = latch == indices.end() ? npos : latch->second;
+    }
+  }
+  nodes_ = layout->nodes.data();
+  children_ = layout->children.data();
+  layout_ = std::move(layout);
+}
+
+std::uint32_t
+FlatTree::add(Layout &layout, const BehaviorPtr &node,
+              std::unordered_map<const BehaviorNode *, std::uint32_t> &indices) {
+  auto added = indices.find(node.get());
+  if (added != indices.end()) {
+    return added->second; // Shared nodes keep a single state
+  }
+
+  auto index = static_cast<std::uint32_t>(layout.nodes.size());
+  indices.emplace(node.get(), index);
+  auto kind = kind_of(*node);
+  layout.nodes.push_back({kind, 0, 0, node.get(), npos});
+  states_.emplace_back();
+  layout.sources.push_back(node);
+
+  // Copy the current state of the source node
+  auto &state = states_.back();
+  if (kind == Kind::SEQUENCE_MEMORY) {
+    auto &memory = static_cast<SequenceMemory &>(*node);
+    state.current_child = static_cast<std::uint32_t>(
+        memory.current_child_ - memory.children().begin());
+  } else if (kind == Kind::FALLBACK_MEMORY) {
+    auto &memory = static_cast<FallbackMemory &>(*node);
+    state.current_child = static_cast<std::uint32_t>(
+        memory.current_child_ - memory.children().begin());
+  } else if (kind == Kind::LATCH) {
+    auto &latch = static_cast<Latch &>(*node);
+    state.latched = latch.latched_;
+    state.result = latch.last_result_;
+  }
+
+  // Opaque nodes tick their children themselves
+  if (kind == Kind::OPAQUE) {
+    return index;
+  }
+  const auto &children = node->children();
+  auto first_child = static_cast<std::uint32_t>(layout.children.size());
+  layout.nodes[index].first_child = first_child;
+  layout.nodes[index].child_count = static_cast<std::uint32_t>(children.size());
+  layout.children.resize(layout.children.size() + children.size());
+  for (std::size_t i = 0; i < children.size(); ++i) {
+    auto child = add(layout, children[i], indices);
+    layout.children[first_child + i] = child;
+  }
+  return index;
+}
+
+FlatTree::Kind FlatTree::kind_of(const BehaviorNode &node) {
+  // Derived classes are opaque because they may override operator()
+  static const std::unordered_map<std::type_index, Kind> kinds = {
+      {typeid(Sequence), Kind::SEQUENCE},
+      {typeid(Fallback), Kind::FALLBACK},
+      {typeid(SequenceMemory), Kind::SEQUENCE_MEMORY},
+      {typeid(FallbackMemory), Kind::FALLBACK_MEMORY},
+      {typeid(Parallel), Kind::PARALLEL},
+      {typeid(Skipper), Kind::SKIPPER},
+      {typeid(Latch), Kind::LATCH},
+      {typeid(Not), Kind::NOT},
+      {typeid(TryElse), Kind::TRY_ELSE},
+      {typeid(IfThen), Kind::IF_THEN},
+      {typeid(IfThenElse), Kind::IF_THEN_ELSE},
+      {typeid(Action), Kind::ACTION},
+      {typeid(Condition), Kind::CONDITION},
+      {typeid(Unlatch), Kind::UNLATCH}};
+  auto kind = kinds.find(typeid(node));
+  return kind == kinds.end() ? Kind::OPAQUE : kind->second;
+}
+
+Status FlatTree::run() {
+  context_.begin();
+  TickContext::Scope scope(&context_);
+  Status result = tick(0);
+  context_.end();
+  return result;
+}
+
+Status FlatTree::dry_run(DryRun &dry_run) {
+  dry_run_ = &dry_run;
+  Status result = run();
+  dry_run_ = nullptr;
+  return result;
+}
+
+FlatTree FlatTree::fork() const { return *this; }
+
+void FlatTree::reset() { reset(0); }
+
+std::size_t FlatTree::size() const { return states_.size(); }
+
+Status FlatTree::tick_child(std::uint32_t parent, std::uint32_t child) {
+  auto index = children_[nodes_[parent].first_child + child];
+  if (states_[index].epoch < states_[parent].epoch) {
+    reset(index);
+  }
+  return tick(index);
+}
+
+void FlatTree::reset(std::uint32_t index) {
+  auto &state = states_[index];
+  state.epoch = ++epoch_;
+  state.current_child = 0;
+  if (nodes_[index].kind == Kind::OPAQUE && !dry_run_) {
+    nodes_[index].source->reset();
+  }
+}
+
+Status FlatTree::tick(std::uint32_t index) {
+  const auto &node = nodes_[index];
+  auto &state = states_[index];
+  switch (node.kind) {
+  case Kind::SEQUENCE:
+    for (std::uint32_t i = 0; i < node.child_count; ++i) {
+      Status result = tick_child(index, i);
+      if (result != Status::Success) {
+        return result;
+      }
+    }
+    return Status::Success;
+
+  case Kind::FALLBACK:
+    for (std::uint32_t i = 0; i < node.child_count; ++i) {
+      Status result = tick_child(index, i);
+      if (result != Status::Failure) {
+        return result;
+      }
+    }
+    return Status::Failure;
+
+  case Kind::SEQUENCE_MEMORY:
+    for (; state.current_child < node.child_count; ++state.current_child) {
+      Status result = tick_child(index, state.current_child);
+      if (result != Status::Success) {
+        return result;
+      }
+    }
+    if (!dry_run_) {
+      library_metrics().add(LibraryMetrics::MEMORY_RESTARTS);
+    }
+    reset(index);
+    return Status::Success;
+
+  case Kind::FALLBACK_MEMORY:
+    for (; state.current_child < node.child_count; ++state.current_child) {
+      Status result = tick_child(index, state.current_child);
+      if (result != Status::Failure) {
+        return result;
+      }
+    }
+    if (!dry_run_) {
+      library_metrics().add(LibraryMetrics::MEMORY_RESTARTS);
+    }
+    reset(index);
+    return Status::Failure;
+
+  case Kind::PARALLEL: {
+    bool all_success = true;
+    for (std::uint32_t i = 0; i < node.child_count; ++i) {
+      Status result = tick_child(index, i);
+      if (result == Status::Running) {
+        return Status::Running;
+      }
+      all_success = all_success && result == Status::Success;
+    }
+    return all_success ? Status::Success : Status::Failure;
+  }
+
+  case Kind::SKIPPER:
+    for (std::uint32_t i = 0; i < node.child_count; ++i) {
+      Status result = tick_child(index, i);
+      if (result != Status::Running) {
+        return result;
+      }
+    }
+    return Status::Running;
+
+  case Kind::LATCH:
+    if (!state.latched) {
+      state.result = tick_child(index, 0);
+      state.latched = true;
+    }
+    return state.result;
+
+  case Kind::NOT: {
+    Status result = tick_child(index, 0);
+    if (result == Status::Success) {
+      return Status::Failure;
+    }
+    return result == Status::Failure ? Status::Success : result;
+  }
+
+  case Kind::TRY_ELSE: {
+    Status result = tick_child(index, 0);
+    return result == Status::Failure ? tick_child(index, 1) : result;
+  }
+
+  case Kind::IF_THEN: {
+    Status result = tick_child(index, 0);
+    if (result == Status::Success) {
+      return tick_child(index, 1);
+    }
+    return result == Status::Failure ? Status::Success : result;
+  }
+
+  case Kind::IF_THEN_ELSE: {
+    Status result = tick_child(index, 0);
+    if (result == Status::Success) {
+      return tick_child(index, 1);
+    }
+    return result == Status::Failure ? tick_child(index, 2) : result;
+  }
+
+  case Kind::ACTION:
+    if (dry_run_) {
+      return tick_dry(index);
+    }
+    return static_cast<Action *>(node.source)->Action::operator()();
+
+  case Kind::CONDITION:
+    if (dry_run_) {
+      return tick_dry(index);
+    }
+    return static_cast<Condition *>(node.source)->Condition::operator()();
+
+  case Kind::UNLATCH:
+    if (dry_run_) {
+      dry_run_->actions.push_back(node.source);
+      if (node.target != npos) {
+        states_[node.target].latched = false;
+      }
+      return dry_run_->action_status;
+    }
+    if (node.target == npos) {
+      return static_cast<Unlatch *>(node.source)->Action::operator()();
+    }
+    states_[node.target].latched = false;
+    return Status::Success;
+
+  case Kind::OPAQUE:
+    if (dry_run_) {
+      return tick_dry(index);
+    }
+    return (*node.source)();
+  }
+  return Status::Failure;
+}
+
+Status FlatTree::tick_dry(std::uint32_t index) {
+  const auto &node = nodes_[index];
+  if (node.kind == Kind::ACTION) {
+    dry_run_->actions.push_back(node.source);
+  }
+  auto overlaid = dry_run_->overlay.find(node.source);
+  if (overlaid != dry_run_->overlay.end()) {
+    return overlaid->second;
+  }
+  switch (node.kind) {
+  case Kind::ACTION:
+    return dry_run_->action_status;
+  case Kind::CONDITION:
+    return static_cast<Condition *>(node.source)->Condition::operator()();
+  default:
+    return dry_run_->opaque_status;
+  }
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,170 @@
+#include "behavior_tree/interrupts.h"
+#include "behavior_tree/tick_control.h"
+#include <algorithm>
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+
+namespace evo::behavior {
+
+InterruptSignal::InterruptSignal() {
+  if (sem_init(&wake_, 0, 0) != 0) {
+    throw std::runtime_error("Cannot create the interrupt semaphore");
+  }
+}
+
+InterruptSignal::~InterruptSignal() { sem_destroy(&wake_); }
+
+void InterruptSignal::raise() {
+  pending_.fetch_add(1, std::memory_order_release);
+  sem_post(&wake_);
+}
+
+bool InterruptSignal::take() {
+  return pending_.exchange(0, std::memory_order_acquire) != 0;
+}
+
+void InterruptSignal::wait() {
+  while (sem_wait(&wake_) != 0 && errno == EINTR) {
+  }
+}
+
+Interrupt::Interrupt(BehaviorPtr subtree, const InterruptPolicy &policy,
+                     ClockPtr clock, std::shared_ptr<InterruptSignal> signal)
+    : subtree_(std::move(subtree)), policy_(policy), clock_(std::move(clock)),
+      signal_(std::move(signal)) {
+  if (!subtree_) {
+    throw std::invalid_argument("Interrupt requires a subtree");
+  }
+}
+
+void Interrupt::trigger() {
+  auto now = clock_->now().time_since_epoch().count();
+  auto expected = IDLE;
+  if (!triggered_at_.compare_exchange_strong(expected, now,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+    coalesced_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  signal_->raise();
+}
+
+const BehaviorPtr &Interrupt::subtree() const { return subtree_; }
+
+const InterruptPolicy &Interrupt::policy() const { return policy_; }
+
+Status Interrupt::last_status() const {
+  return last_status_.load(std::memory_order_acquire);
+}
+
+InterruptStats Interrupt::stats() const {
+  InterruptStats stats;
+  stats.services = services_.load(std::memory_order_relaxed);
+  stats.coalesced = coalesced_.load(std::memory_order_relaxed);
+  stats.late = late_.load(std::memory_order_relaxed);
+  stats.last_latency =
+      Clock::Duration(last_latency_.load(std::memory_order_relaxed));
+  stats.max_latency =
+      Clock::Duration(max_latency_.load(std::memory_order_relaxed));
+  return stats;
+}
+
+void Interrupt::service() {
+  // Clear the trigger first, so that triggers during the tick are kept
+  auto triggered = triggered_at_.exchange(IDLE, std::memory_order_acquire);
+  if (triggered == IDLE) {
+    return;
+  }
+  auto latency = clock_->now().time_since_epoch().count() - triggered;
+  last_latency_.store(latency, std::memory_order_relaxed);
+  if (latency > max_latency_.load(std::memory_order_relaxed)) {
+    max_latency_.store(latency, std::memory_order_relaxed);
+  }
+  if (policy_.latency_bound > Clock::Duration::zero() &&
+      latency > policy_.latency_bound.count()) {
+    late_.fetch_add(1, std::memory_order_relaxed);
+  }
+  services_.fetch_add(1, std::memory_order_relaxed);
+  last_status_.store((*subtree_)(), std::memory_order_release);
+}
+
+InterruptService::InterruptService()
+    : signal_(std::make_shared<InterruptSignal>()) {}
+
+InterruptService::~InterruptService() {
+  if (!thread_.joinable()) {
+    return;
+  }
+  stop_.store(true, std::memory_order_relaxed);
+  signal_->raise();
+  thread_.join();
+}
+
+std::shared_ptr<Interrupt>
+InterruptService::add(BehaviorPtr subtree, const InterruptPolicy &policy,
+                      ClockPtr clock) {
+  auto interrupt = std::make_shared<Interrupt>(std::move(subtree), policy,
+                                               std::move(clock), signal_);
+  std::lock_guard<std::mutex> lock(tick_mutex_);
+  start();
+  auto position = std::find_if(
+      interrupts_.begin(), interrupts_.end(), [&](const auto &other) {
+        return other->policy().priority < policy.priority;
+      });
+  interrupts_.insert(position, interrupt);
+  return interrupt;
+}
+
+void InterruptService::remove(const std::shared_ptr<Interrupt> &interrupt) {
+  std::lock_guard<std::mutex> lock(tick_mutex_);
+  interrupts_.erase(
+      std::remove(interrupts_.begin(), interrupts_.end(), interrupt),
+      interrupts_.end());
+}
+
+bool InterruptService::empty() const { return interrupts_.empty(); }
+
+std::mutex &InterruptService::tick_mutex() { return tick_mutex_; }
+
+void InterruptService::service() {
+  if (!signal_->take()) {
+    return;
+  }
+  // Interrupt subtrees are ticked completely and without the control of the
+  // preempted tick
+  TickControl::Scope scope(nullptr);
+  for (const auto &interrupt : interrupts_) {
+    interrupt->service();
+  }
+}
+
+bool InterruptService::set_thread_priority(int priority) {
+  std::lock_guard<std::mutex> lock(tick_mutex_);
+  start();
+  sched_param param{};
+  param.sched_priority = priority;
+  return pthread_setschedparam(thread_.native_handle(),
+                               priority > 0 ? SCHED_FIFO : SCHED_OTHER,
+                               &param) == 0;
+}
+
+void InterruptService::start() {
+  if (!thread_.joinable()) {
+    thread_ = std::thread([this] { serve(); });
+  }
+}
+
+void InterruptService::serve() {
+  while (true) {
+    signal_->wait();
+    if (stop_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(tick_mutex_);
+    service();
+  }
+}
+
+} // namespace evo::behavior
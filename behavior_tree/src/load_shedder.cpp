@@ -0,0 +1,38 @@
+#include "behavior_tree/load_shedder.h"
+
+namespace evo::behavior {
+
+LoadShedder::LoadShedder(const LoadSheddingPolicy &policy) : policy_(policy) {}
+
+const LoadSheddingPolicy &LoadShedder::policy() const { return policy_; }
+
+bool LoadShedder::active() const { return active_; }
+
+double LoadShedder::load() const { return load_; }
+
+void LoadShedder::record_tick(Clock::Duration duration) {
+  double load = std::chrono::duration<double>(duration) /
+                std::chrono::duration<double>(policy_.period);
+  load_ = recorded_ ? load_ + policy_.smoothing * (load - load_) : load;
+  recorded_ = true;
+  // Hysteresis: different thresholds to start and to stop shedding
+  if (load_ > policy_.overload_fraction) {
+    active_ = true;
+  } else if (load_ < policy_.recovery_fraction) {
+    active_ = false;
+  }
+}
+
+std::optional<Status> LoadShedder::shed(const BehaviorNode &node) {
+  if (!active_ || node.priority() >= policy_.threshold) {
+    return std::nullopt;
+  }
+  ++shed_counts_[node.priority()];
+  return policy_.shed_status;
+}
+
+const std::map<int, std::uint64_t> &LoadShedder::shed_counts() const {
+  return shed_counts_;
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,379 @@
+#include "behavior_tree/metrics.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace evo::behavior {
+
+namespace {
+
+/// The names of the statuses, indexed by Status::State.
+constexpr const char *status_names[] = {"failure", "success", "running",
+                                        "incomplete"};
+
+/// The counters of a tree before its buckets: ticks and the duration sum.
+constexpr std::size_t tree_counters = 2;
+
+/// Escapes a label value or a help text.
+std::string escape(const std::string &text, bool quotes) {
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (char c : text) {
+    if (c == '\\') {
+      escaped += "\\\\";
+    } else if (c == '\n') {
+      escaped += "\\n";
+    } else if (c == '"' && quotes) {
+      escaped += "\\\"";
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+/// Formats a sample value or a bucket bound.
+std::string format(double value) {
+  if (std::isinf(value)) {
+    return value > 0 ? "+Inf" : "-Inf";
+  }
+  if (std::isnan(value)) {
+    return "NaN";
+  }
+  if (value == std::floor(value) && std::fabs(value) < 1e15) {
+    return std::to_string(static_cast<long long>(value));
+  }
+  // Use the shortest precision which reads back as the same value
+  for (int precision = std::numeric_limits<double>::digits10;;
+       ++precision) {
+    std::ostringstream out;
+    out << std::setprecision(precision) << value;
+    if (precision == std::numeric_limits<double>::max_digits10 ||
+        std::stod(out.str()) == value) {
+      return out.str();
+    }
+  }
+}
+
+/// Gathers the samples of all sources by family.
+class FamilyBuffer : public MetricsWriter {
+public:
+  void family(const std::string &name, const std::string &type,
+              const std::string &help) override {
+    auto family = index_.find(name);
+    if (family == index_.end()) {
+      family = index_.emplace(name, families_.size()).first;
+      families_.push_back({name, type, help, {}});
+    }
+    current_ = family->second;
+  }
+
+  void sample(const std::string &name, const MetricLabels &labels,
+              double value) override {
+    if (current_ >= families_.size()) {
+      throw std::logic_error("Metric sample '" + name + "' without family");
+    }
+    families_[current_].samples.push_back({name, labels, value});
+  }
+
+  /// Passes the families in the order they were first announced.
+  void flush(MetricsWriter &writer) const {
+    for (const auto &family : families_) {
+      writer.family(family.name, family.type, family.help);
+      for (const auto &sample : family.samples) {
+        writer.sample(sample.name, sample.labels, sample.value);
+      }
+    }
+  }
+
+private:
+  struct Sample {
+    std::string name;
+    MetricLabels labels;
+    double value;
+  };
+
+  struct Family {
+    std::string name;
+    std::string type;
+    std::string help;
+    std::vector<Sample> samples;
+  };
+
+  std::vector<Family> families_;
+  std::map<std::string, std::size_t> index_;
+  std::size_t current_ = std::numeric_limits<std::size_t>::max();
+};
+
+/// The library's counters, shared with the global registry.
+const std::shared_ptr<LibraryMetrics> &library_source() {
+  static const auto source = std::make_shared<LibraryMetrics>();
+  return source;
+}
+
+} // namespace
+
+ShardedCounters::ShardedCounters(std::size_t size)
+    : size_(size), stride_((size + 7) / 8 * 8),
+      lines_(new Line[shards * stride_ / 8]) {
+  for (std::size_t position = 0; position < shards * stride_; ++position) {
+    counter(position).store(0, std::memory_order_relaxed);
+  }
+}
+
+std::size_t ShardedCounters::assign_shard() {
+  static std::atomic<std::size_t> next{0};
+  return next.fetch_add(1, std::memory_order_relaxed) % shards;
+}
+
+std::uint64_t ShardedCounters::value(std::size_t index) const {
+  std::uint64_t sum = 0;
+  for (std::size_t shard = 0; shard < shards; ++shard) {
+    sum += counter(shard * stride_ + index).load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+std::size_t ShardedCounters::size() const { return size_; }
+
+PrometheusWriter::PrometheusWriter(std::ostream &out) : out_(out) {}
+
+void PrometheusWriter::family(const std::string &name, const std::string &type,
+                              const std::string &help) {
+  out_ << "# HELP " << name << ' ' << escape(help, false) << '\n';
+  out_ << "# TYPE " << name << ' ' << type << '\n';
+}
+
+void PrometheusWriter::sample(const std::string &name,
+                              const MetricLabels &labels, double value) {
+  out_ << name;
+  if (!labels.empty()) {
+    out_ << '{';
+    for (std::size_t i = 0; i < labels.size(); ++i) {
+      out_ << (i ? "," : "") << labels[i].first << "=\""
+           << escape(labels[i].second, true) << '"';
+    }
+    out_ << '}';
+  }
+  out_ << ' ' << format(value) << '\n';
+}
+
+MetricsRegistry &MetricsRegistry::global() {
+  static MetricsRegistry registry;
+  static const bool initialized = (registry.add(library_source()), true);
+  (void)initialized;
+  return registry;
+}
+
+void MetricsRegistry::add(const std::shared_ptr<const MetricsSource> &source) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  sources_.push_back(source);
+}
+
+void MetricsRegistry::remove(const MetricsSource *source) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  sources_.erase(std::remove_if(sources_.begin(), sources_.end(),
+                                [source](const auto &registered) {
+                                  auto locked = registered.lock();
+                                  return !locked || locked.get() == source;
+                                }),
+                 sources_.end());
+}
+
+void MetricsRegistry::write(MetricsWriter &writer) const {
+  std::vector<std::shared_ptr<const MetricsSource>> sources;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sources_.erase(std::remove_if(sources_.begin(), sources_.end(),
+                                  [](const auto &registered) {
+                                    return registered.expired();
+                                  }),
+                   sources_.end());
+    for (const auto &source : sources_) {
+      if (auto locked = source.lock()) {
+        sources.push_back(std::move(locked));
+      }
+    }
+  }
+  FamilyBuffer buffer;
+  for (const auto &source : sources) {
+    source->collect(buffer);
+  }
+  buffer.flush(writer);
+}
+
+std::string MetricsRegistry::scrape() const {
+  std::ostringstream out;
+  PrometheusWriter writer(out);
+  write(writer);
+  return out.str();
+}
+
+LibraryMetrics::LibraryMetrics() : counters_(COUNTER_COUNT) {}
+
+std::uint64_t LibraryMetrics::value(Counter counter) const {
+  return counters_.value(counter);
+}
+
+void LibraryMetrics::collect(MetricsWriter &writer) const {
+  writer.family("bt_action_exceptions_total", "counter",
+                "Exceptions caught by action nodes.");
+  writer.sample("bt_action_exceptions_total", {},
+                static_cast<double>(value(ACTION_EXCEPTIONS)));
+  writer.family("bt_condition_exceptions_total", "counter",
+                "Exceptions caught by condition nodes.");
+  writer.sample("bt_condition_exceptions_total", {},
+                static_cast<double>(value(CONDITION_EXCEPTIONS)));
+  writer.family("bt_memory_node_restarts_total", "counter",
+                "Memory nodes which completed and restarted from their first "
+                "child.");
+  writer.sample("bt_memory_node_restarts_total", {},
+                static_cast<double>(value(MEMORY_RESTARTS)));
+}
+
+LibraryMetrics &library_metrics() { return *library_source(); }
+
+TreeMetrics::TreeMetrics(std::string tree, ClockPtr clock,
+                         std::vector<double> buckets)
+    : tree_(std::move(tree)), clock_(std::move(clock)),
+      buckets_(std::move(buckets)) {
+  if (!std::is_sorted(buckets_.begin(), buckets_.end())) {
+    throw std::invalid_argument("Histogram buckets must be increasing");
+  }
+  set_root(nullptr);
+}
+
+std::vector<double> TreeMetrics::default_buckets() {
+  return {1e-6, 5e-6, 1e-5, 5e-5, 1e-4, 5e-4, 1e-3,
+          5e-3, 1e-2, 5e-2, 1e-1, 5e-1, 1.0};
+}
+
+void TreeMetrics::set_root(const BehaviorPtr &root) {
+  set_index(std::make_shared<NodeIndex>(root));
+}
+
+void TreeMetrics::set_index(std::shared_ptr<const NodeIndex> index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  index_ = std::move(index);
+  nodes_.clear();
+  for (std::uint32_t id = 0; id < index_->size(); ++id) {
+    auto node = index_->node(id);
+    nodes_.push_back(node ? NodeInfo{node->type(), node->description()}
+                          : NodeInfo{});
+  }
+  counters_ = std::make_unique<ShardedCounters>(
+      node_offset(static_cast<std::uint32_t>(nodes_.size())));
+  depth_ = 0;
+}
+
+void TreeMetrics::set_clock(ClockPtr clock) { clock_ = std::move(clock); }
+
+std::size_t TreeMetrics::node_offset(std::uint32_t id) const {
+  return tree_counters + buckets_.size() + 1 + id * node_counters;
+}
+
+std::uint64_t TreeMetrics::ticks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return counters_->value(0);
+}
+
+std::uint64_t TreeMetrics::visits(const BehaviorNode &node) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto id = index_->find(node);
+  return id ? counters_->value(node_offset(*id)) : 0;
+}
+
+std::uint64_t TreeMetrics::count(const BehaviorNode &node,
+                                 Status status) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto id = index_->find(node);
+  return id ? counters_->value(node_offset(*id) + 1 + Status::State(status))
+            : 0;
+}
+
+void TreeMetrics::on_enter(const BehaviorNode &node) {
+  if (depth_++ == 0) {
+    start_ = clock_->now();
+  }
+  if (auto id = index_->find(node)) {
+    counters_->add_exclusive(node_offset(*id));
+  }
+}
+
+void TreeMetrics::on_exit(const BehaviorNode &node, Status status) {
+  if (auto id = index_->find(node)) {
+    counters_->add_exclusive(node_offset(*id) + 1 + Status::State(status));
+  }
+  if (depth_ == 0 || --depth_ != 0) {
+    return;
+  }
+  auto duration = clock_->now() - start_;
+  auto nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+  auto seconds = std::chrono::duration<double>(duration).count();
+  auto bucket = static_cast<std::size_t>(
+      std::lower_bound(buckets_.begin(), buckets_.end(), seconds) -
+      buckets_.begin());
+  counters_->add_exclusive(0);
+  counters_->add_exclusive(
+      1, static_cast<std::uint64_t>(std::max<long long>(nanoseconds, 0)));
+  counters_->add_exclusive(tree_counters + bucket);
+}
+
+void TreeMetrics::collect(MetricsWriter &writer) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const MetricLabels tree{{"tree", tree_}};
+  auto ticks = counters_->value(0);
+
+  writer.family("bt_ticks_total", "counter", "Completed ticks of the tree.");
+  writer.sample("bt_ticks_total", tree, static_cast<double>(ticks));
+
+  writer.family("bt_tick_duration_seconds", "histogram",
+                "Duration of the ticks of the tree.");
+  std::uint64_t cumulative = 0;
+  for (std::size_t bucket = 0; bucket <= buckets_.size(); ++bucket) {
+    cumulative += counters_->value(tree_counters + bucket);
+    auto labels = tree;
+    labels.emplace_back("le", bucket < buckets_.size()
+                                  ? format(buckets_[bucket])
+                                  : format(std::numeric_limits<
+                                           double>::infinity()));
+    writer.sample("bt_tick_duration_seconds_bucket", labels,
+                  static_cast<double>(cumulative));
+  }
+  writer.sample("bt_tick_duration_seconds_sum", tree,
+                static_cast<double>(counters_->value(1)) * 1e-9);
+  writer.sample("bt_tick_duration_seconds_count", tree,
+                static_cast<double>(cumulative));
+
+  writer.family("bt_node_visits_total", "counter",
+                "Ticks of each node of the tree.");
+  for (std::uint32_t id = 0; id < nodes_.size(); ++id) {
+    writer.sample("bt_node_visits_total",
+                  {{"tree", tree_},
+                   {"node", std::to_string(id)},
+                   {"type", nodes_[id].type},
+                   {"description", nodes_[id].description}},
+                  static_cast<double>(counters_->value(node_offset(id))));
+  }
+
+  writer.family("bt_node_status_total", "counter",
+                "Statuses returned by each node of the tree.");
+  for (std::uint32_t id = 0; id < nodes_.size(); ++id) {
+    for (std::size_t state = 0; state < 4; ++state) {
+      writer.sample(
+          "bt_node_status_total",
+          {{"tree", tree_},
+           {"node", std::to_string(id)},
+           {"status", status_names[state]}},
+          static_cast<double>(counters_->value(node_offset(id) + 1 + state)));
+    }
+  }
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,49 @@
+#include "behavior_tree/node_index.h"
+#include <atomic>
+
+namespace evo::behavior {
+
+namespace {
+
+/// Source of index generations, 0 marks nodes without an index.
+std::atomic<std::uint64_t> last_generation{0};
+
+} // namespace
+
+NodeIndex::NodeIndex(const BehaviorPtr &root)
+    : generation_(last_generation.fetch_add(1, std::memory_order_relaxed) +
+                  1) {
+  std::vector<BehaviorPtr> pending;
+  if (root) {
+    pending.push_back(root);
+  }
+  while (!pending.empty()) {
+    auto node = std::move(pending.back());
+    pending.pop_back();
+    auto id = static_cast<std::uint32_t>(nodes_.size());
+    if (!ids_.emplace(node.get(), id).second) {
+      continue;
+    }
+    node->index_.generation = generation_;
+    node->index_.id = id;
+    nodes_.push_back(node);
+    const auto &children = node->children();
+    pending.insert(pending.end(), children.rbegin(), children.rend());
+  }
+}
+
+std::shared_ptr<const BehaviorNode> NodeIndex::node(std::uint32_t id) const {
+  return id < nodes_.size() ? nodes_[id].lock() : nullptr;
+}
+
+std::optional<std::uint32_t>
+NodeIndex::find_by_address(const BehaviorNode &node) const {
+  auto id = ids_.find(&node);
+  // A new node may have taken the address of a freed one
+  if (id == ids_.end() || nodes_[id->second].expired()) {
+    return std::nullopt;
+  }
+  return id->second;
+}
+
+} // namespace evo::behavior
@@ -1,3 +1,4 @@
+#include <behavior_tree/metrics.h>
 #include <behavior_tree/nodes/action.h>
 #include <iostream>
 
@@ -6,16 +7,26 @@ namespace evo::behavior {
 Action::Action(std::function<void()> behavior, std::string const &description)
     : BehaviorNode("action", description), behavior_(behavior) {}
 
+Action::Action(std::function<void(TickContext &)> behavior,
+               std::string const &description)
+    : BehaviorNode("action", description), contextual_(std::move(behavior)) {}
+
 Status Action::operator()() {
   try {
-    behavior_();
+    if (contextual_) {
+      with_tick_context(contextual_);
+    } else {
+      behavior_();
+    }
   } catch (const std::exception &e) {
     // In case of an exception, log it with the description of the action.
+    library_metrics().add(LibraryMetrics::ACTION_EXCEPTIONS);
     std::cout << "Exception in behavior action '" << description()
               << "': " << e.what() << std::endl;
     return Status::Failure;
   } catch (...) {
     // Catch any other exceptions and log with the description of the action.
+    library_metrics().add(LibraryMetrics::ACTION_EXCEPTIONS);
     std::cout << "Unknown exception in behavior action '" << description()
               << "'." << std::endl;
     return Status::Failure;
@@ -1,13 +1,56 @@
 #include <behavior_tree/nodes/behavior_node.h>
+#include <behavior_tree/tick_control.h>
+#include <atomic>
+#include <stdexcept>
 
 namespace evo::behavior {
 
+namespace {
+
+/// Source of reset epochs shared by all the nodes. Epochs only grow, so a node
+/// whose epoch is lower than its parent's one has missed the parent's reset.
+std::atomic<std::uint64_t> last_epoch{0};
+
+} // namespace
+
 void BehaviorNode::reset() {
-  for (auto const &child : children()) {
+  epoch_ = last_epoch.fetch_add(1, std::memory_order_relaxed) + 1;
+  resume_child_ = 0;
+}
+
+Status BehaviorNode::tick_child(const BehaviorPtr &child) {
+  auto *control = TickControl::current();
+  if (control) {
+    control->poll_interrupts();
+    if (control->suspend_requested()) {
+      return Status::Incomplete;
+    }
+    if (auto shed_status = control->shed(*child)) {
+      return *shed_status;
+    }
+  }
+  if (child->epoch_ < epoch_) {
     child->reset();
+    // Overrides which do not call BehaviorNode::reset() must not be reset
+    // again on every tick.
+    if (child->epoch_ < epoch_) {
+      child->epoch_ = epoch_;
+    }
+  }
+  if (!control) {
+    return (*child)();
+  }
+  control->enter(*child);
+  Status result = (*child)();
+  control->exit(*child, result);
+  if (result != Status::Incomplete) {
+    control->mark_progress();
   }
+  return result;
 }
 
+void BehaviorNode::preallocate() {}
+
 const std::string &BehaviorNode::type() const { return type_; }
 
 const std::string &BehaviorNode::description() const { return description_; }
@@ -16,4 +59,19 @@ const BehaviorNode::Children &BehaviorNode::children() const {
   return children_;
 }
 
+int BehaviorNode::priority() const { return priority_; }
+
+void BehaviorNode::set_priority(int priority) { priority_ = priority; }
+
+void BehaviorNode::replace_child(std::size_t index, BehaviorPtr child) {
+  if (index >= children_.size()) {
+    throw std::out_of_range("Node has no child at index " +
+                            std::to_string(index));
+  }
+  if (!child) {
+    throw std::invalid_argument("Replacement child must not be null");
+  }
+  children_[index] = std::move(child);
+}
+
 } // namespace evo::behavior
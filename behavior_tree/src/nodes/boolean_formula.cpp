@@ -0,0 +1,340 @@
+#include "behavior_tree/nodes/boolean_formula.h"
+#include "behavior_tree/nodes/condition.h"
+#include "behavior_tree/nodes/decorators/not.h"
+#include "behavior_tree/nodes/fallback.h"
+#include "behavior_tree/nodes/sequence.h"
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace evo::behavior {
+
+namespace {
+
+/// References of the constant diagram nodes.
+constexpr std::uint32_t FALSE_NODE = 0;
+constexpr std::uint32_t TRUE_NODE = 1;
+
+/// Binary operations applied to decision diagrams.
+enum class Operation { AND, OR };
+
+std::uint64_t pair_key(std::uint32_t first, std::uint32_t second) {
+  return (std::uint64_t(first) << 32) | second;
+}
+
+} // namespace
+
+/// Builds a reduced ordered decision diagram whose variables are the
+/// conditions in the order of their first appearance in the subtree.
+class BooleanFormula::Builder {
+public:
+  explicit Builder(BooleanFormula &formula) : formula_(formula) {
+    formula_.diagram_ = {{0, FALSE_NODE, FALSE_NODE},
+                         {0, TRUE_NODE, TRUE_NODE}};
+  }
+
+  /// Returns the diagram of a subtree, registering its conditions as children.
+  /// Also appends the subtree's terms.
+  std::uint32_t build(const BehaviorPtr &node) {
+    const auto &type = typeid(*node);
+    auto term = formula_.terms_.size();
+    formula_.terms_.push_back({Term::CONDITION, 0, 0});
+    std::uint32_t result;
+    if (type == typeid(Condition)) {
+      formula_.terms_[term].condition = condition_of(node);
+      result = make(formula_.terms_[term].condition, FALSE_NODE, TRUE_NODE);
+    } else if (type == typeid(Not)) {
+      formula_.terms_[term].kind = Term::NOT;
+      std::unordered_map<std::uint32_t, std::uint32_t> memo;
+      result = negate(build(node->children().front()), memo);
+    } else {
+      bool is_sequence = type == typeid(Sequence);
+      formula_.terms_[term].kind =
+          is_sequence ? Term::SEQUENCE : Term::FALLBACK;
+      auto operation = is_sequence ? Operation::AND : Operation::OR;
+      result = is_sequence ? TRUE_NODE : FALSE_NODE;
+      for (const auto &child : node->children()) {
+        auto child_diagram = build(child);
+        std::unordered_map<std::uint64_t, std::uint32_t> memo;
+        result = apply(operation, result, child_diagram, memo);
+      }
+    }
+    formula_.terms_[term].end =
+        static_cast<std::uint32_t>(formula_.terms_.size());
+    return result;
+  }
+
+private:
+  /// Returns the variable of a condition, adding it on first use.
+  std::uint32_t condition_of(const BehaviorPtr &node) {
+    auto [known, inserted] = conditions_.emplace(
+        node.get(), static_cast<std::uint32_t>(formula_.children_.size()));
+    if (inserted) {
+      formula_.children_.push_back(node);
+    }
+    return known->second;
+  }
+
+  /// Returns the unique node testing a condition, or a branch if both are
+  /// the same.
+  std::uint32_t make(std::uint32_t condition, std::uint32_t low,
+                     std::uint32_t high) {
+    if (low == high) {
+      return low;
+    }
+    auto reference = static_cast<std::uint32_t>(formula_.diagram_.size());
+    auto [known, inserted] =
+        unique_.emplace(std::make_tuple(condition, low, high), reference);
+    if (inserted) {
+      formula_.diagram_.push_back({condition, low, high});
+    }
+    return known->second;
+  }
+
+  /// Returns the condition tested by a diagram, constants test none.
+  std::uint32_t top(std::uint32_t reference) const {
+    return reference <= TRUE_NODE ? UINT32_MAX
+                                  : formula_.diagram_[reference].condition;
+  }
+
+  std::uint32_t negate(std::uint32_t reference,
+                       std::unordered_map<std::uint32_t, std::uint32_t> &memo) {
+    if (reference <= TRUE_NODE) {
+      return reference == TRUE_NODE ? FALSE_NODE : TRUE_NODE;
+    }
+    if (auto known = memo.find(reference); known != memo.end()) {
+      return known->second;
+    }
+    auto node = formula_.diagram_[reference];
+    auto result =
+        make(node.condition, negate(node.low, memo), negate(node.high, memo));
+    memo.emplace(reference, result);
+    return result;
+  }
+
+  std::uint32_t apply(Operation operation, std::uint32_t left,
+                      std::uint32_t right,
+                      std::unordered_map<std::uint64_t, std::uint32_t> &memo) {
+    auto absorbing = operation == Operation::AND ? FALSE_NODE : TRUE_NODE;
+    auto neutral = operation == Operation::AND ? TRUE_NODE : FALSE_NODE;
+    if (left == absorbing || right == absorbing) {
+      return absorbing;
+    }
+    if (left == neutral || left == right) {
+      return right;
+    }
+    if (right == neutral) {
+      return left;
+    }
+    if (left > right) {
+      std::swap(left, right); // Both operations are commutative
+    }
+    auto key = pair_key(left, right);
+    if (auto known = memo.find(key); known != memo.end()) {
+      return known->second;
+    }
+    auto condition = std::min(top(left), top(right));
+    auto cofactor = [&](std::uint32_t reference, bool high) {
+      if (top(reference) != condition) {
+        return reference;
+      }
+      const auto &node = formula_.diagram_[reference];
+      return high ? node.high : node.low;
+    };
+    auto low = apply(operation, cofactor(left, false), cofactor(right, false),
+                     memo);
+    auto high =
+        apply(operation, cofactor(left, true), cofactor(right, true), memo);
+    auto result = make(condition, low, high);
+    memo.emplace(key, result);
+    return result;
+  }
+
+  /// The formula being built.
+  BooleanFormula &formula_;
+  /// Variables of the conditions.
+  std::unordered_map<const BehaviorNode *, std::uint32_t> conditions_;
+  /// Diagram nodes by their contents, which keeps the diagram reduced.
+  std::map<std::tuple<std::uint32_t, std::uint32_t, std::uint32_t>,
+           std::uint32_t>
+      unique_;
+};
+
+BooleanFormula::BooleanFormula(const BehaviorPtr &subtree)
+    : BehaviorNode("boolean_formula",
+                   subtree ? subtree->description() : std::string()) {
+  if (!subtree || !is_pure(*subtree)) {
+    throw std::invalid_argument(
+        "Only Condition, Not, Sequence and Fallback nodes can be compiled "
+        "into a boolean formula");
+  }
+  root_ = Builder(*this).build(subtree);
+  sampled_.assign(children_.size() / 64 + 1, 0);
+  running_.assign(sampled_.size(), 0);
+
+  if (uses_table()) {
+    std::size_t rows = std::size_t(1) << children_.size();
+    table_.assign((rows + 63) / 64, 0);
+    for (std::size_t row = 0; row < rows; ++row) {
+      sampled_[0] = row;
+      if (evaluate_diagram()) {
+        table_[row / 64] |= std::uint64_t(1) << (row % 64);
+      }
+    }
+    sampled_[0] = 0;
+  }
+}
+
+bool BooleanFormula::is_pure(const BehaviorNode &subtree) {
+  const auto &type = typeid(subtree);
+  if (type == typeid(Condition)) {
+    return true;
+  }
+  if (type != typeid(Not) && type != typeid(Sequence) &&
+      type != typeid(Fallback)) {
+    return false;
+  }
+  for (const auto &child : subtree.children()) {
+    if (!is_pure(*child)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status BooleanFormula::operator()() {
+  if (resume_child_ == 0) {
+    std::fill(sampled_.begin(), sampled_.end(), 0);
+    std::fill(running_.begin(), running_.end(), 0);
+  }
+  for (auto i = resume_child_; i < children_.size(); ++i) {
+    Status result = tick_child(children_[i]);
+    if (result == Status::Incomplete) {
+      resume_child_ = i; // Keep the sampled conditions for the next tick
+      return result;
+    }
+    if (result == Status::Success) {
+      sampled_[i / 64] |= std::uint64_t(1) << (i % 64);
+    } else if (result == Status::Running) {
+      running_[i / 64] |= std::uint64_t(1) << (i % 64);
+    }
+  }
+  resume_child_ = 0;
+
+  if (std::any_of(running_.begin(), running_.end(),
+                  [](std::uint64_t bits) { return bits != 0; })) {
+    // Running is not a boolean, evaluate the subtree as it would tick
+    return evaluate_terms(0);
+  }
+  if (!table_.empty()) {
+    auto row = sampled_[0];
+    return Status(((table_[row / 64] >> (row % 64)) & 1) != 0);
+  }
+  return Status(evaluate_diagram());
+}
+
+bool BooleanFormula::uses_table() const {
+  return children_.size() <= max_table_conditions;
+}
+
+std::size_t BooleanFormula::diagram_size() const {
+  return diagram_.size() - 2;
+}
+
+bool BooleanFormula::evaluate_diagram() const {
+  auto reference = root_;
+  while (reference > TRUE_NODE) {
+    const auto &node = diagram_[reference];
+    reference = test(sampled_, node.condition) ? node.high : node.low;
+  }
+  return reference == TRUE_NODE;
+}
+
+Status::State BooleanFormula::evaluate_terms(std::uint32_t term) const {
+  const auto &node = terms_[term];
+  switch (node.kind) {
+  case Term::CONDITION:
+    if (test(running_, node.condition)) {
+      return Status::RUNNING;
+    }
+    return test(sampled_, node.condition) ? Status::SUCCESS : Status::FAILURE;
+  case Term::NOT: {
+    auto result = evaluate_terms(term + 1);
+    if (result == Status::RUNNING) {
+      return result;
+    }
+    return result == Status::SUCCESS ? Status::FAILURE : Status::SUCCESS;
+  }
+  default: {
+    // A sequence continues on success, a fallback on failure
+    auto next = node.kind == Term::SEQUENCE ? Status::SUCCESS : Status::FAILURE;
+    for (auto child = term + 1; child < node.end; child = terms_[child].end) {
+      auto result = evaluate_terms(child);
+      if (result != next) {
+        return result;
+      }
+    }
+    return next;
+  }
+  }
+}
+
+bool BooleanFormula::test(const std::vector<std::uint64_t> &bits,
+                          std::size_t index) {
+  return (bits[index / 64] >> (index % 64)) & 1;
+}
+
+namespace {
+
+/// Counts the distinct conditions of a pure subtree.
+std::size_t count_conditions(const BehaviorNode &node,
+                             std::unordered_map<const BehaviorNode *, bool> &seen) {
+  if (typeid(node) == typeid(Condition)) {
+    return seen.emplace(&node, true).second ? 1 : 0;
+  }
+  std::size_t count = 0;
+  for (const auto &child : node.children()) {
+    count += count_conditions(*child, seen);
+  }
+  return count;
+}
+
+BehaviorPtr compile(const BehaviorPtr &node, std::size_t min_conditions,
+                    std::unordered_map<const BehaviorNode *, BehaviorPtr> &done) {
+  if (auto known = done.find(node.get()); known != done.end()) {
+    return known->second;
+  }
+  BehaviorPtr result = node;
+  if (typeid(*node) != typeid(Condition) && BooleanFormula::is_pure(*node)) {
+    std::unordered_map<const BehaviorNode *, bool> seen;
+    if (count_conditions(*node, seen) >= min_conditions) {
+      result = std::make_shared<BooleanFormula>(node);
+    }
+  } else {
+    for (std::size_t i = 0; i < node->children().size(); ++i) {
+      const auto &child = node->children()[i];
+      auto compiled = compile(child, min_conditions, done);
+      if (compiled != child) {
+        node->replace_child(i, compiled);
+      }
+    }
+  }
+  done.emplace(node.get(), result);
+  return result;
+}
+
+} // namespace
+
+BehaviorPtr compile_conditions(const BehaviorPtr &root,
+                               std::size_t min_conditions) {
+  if (!root) {
+    throw std::invalid_argument("compile_conditions requires a root node");
+  }
+  std::unordered_map<const BehaviorNode *, BehaviorPtr> done;
+  return compile(root, min_conditions, done);
+}
+
+} // namespace evo::behavior
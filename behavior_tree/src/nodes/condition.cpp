@@ -1,3 +1,4 @@
+#include <behavior_tree/metrics.h>
 #include <behavior_tree/nodes/condition.h>
 #include <iostream>
 
@@ -7,14 +8,38 @@ Condition::Condition(std::function<Status()> condition,
                      const std::string &description)
     : BehaviorNode("condition", description), condition_(condition) {}
 
+Condition::Condition(std::function<Status(TickContext &)> condition,
+                     const std::string &description)
+    : BehaviorNode("condition", description),
+      contextual_(std::move(condition)) {}
+
 Status Condition::operator()() {
+  return has_prefetched_ ? prefetched_ : evaluate();
+}
+
+bool Condition::prefetchable() const { return prefetchable_; }
+
+void Condition::set_prefetchable(bool prefetchable) {
+  prefetchable_ = prefetchable;
+}
+
+void Condition::prefetch() {
+  prefetched_ = evaluate();
+  has_prefetched_ = true;
+}
+
+void Condition::discard_prefetched() { has_prefetched_ = false; }
+
+Status Condition::evaluate() const {
   try {
-    return condition_();
+    return contextual_ ? with_tick_context(contextual_) : condition_();
   } catch (const std::exception &e) {
+    library_metrics().add(LibraryMetrics::CONDITION_EXCEPTIONS);
     std::cerr << "Exception in behavior condition '" << description()
               << "': " << e.what() << std::endl;
     return Status::Failure;
   } catch (...) {
+    library_metrics().add(LibraryMetrics::CONDITION_EXCEPTIONS);
     std::cerr << "Unknown exception in behavior condition '" << description()
               << "'." << std::endl;
     return Status::Failure;
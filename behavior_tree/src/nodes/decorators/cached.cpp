@@ -0,0 +1,29 @@
+#include "behavior_tree/nodes/decorators/cached.h"
+#include "behavior_tree/tick_context.h"
+
+namespace evo::behavior {
+
+Cached::Cached(BehaviorPtr child, Clock::Duration ttl, ClockPtr clock)
+    : BehaviorNode("cached", "Caching " + child->description(), child),
+      ttl_(ttl), clock_(std::move(clock)) {}
+
+Status Cached::operator()() {
+  auto now = tick_time(*clock_);
+  if (cached_ && now < expiry_) {
+    return result_;
+  }
+  result_ = tick_child(children().front());
+  cached_ = result_ == Status::Success || result_ == Status::Failure;
+  expiry_ = now + ttl_;
+  if (cached_) {
+    clock_->add_deadline(expiry_);
+  }
+  return result_;
+}
+
+void Cached::reset() {
+  BehaviorNode::reset();
+  cached_ = false;
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,93 @@
+#include "behavior_tree/nodes/decorators/lazy.h"
+#include "behavior_tree/tick_context.h"
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+namespace evo::behavior {
+
+Lazy::Lazy(Builder builder, const std::string &description,
+           Clock::Duration idle_timeout, ClockPtr clock)
+    : BehaviorNode("lazy", description), builder_(std::move(builder)),
+      idle_timeout_(idle_timeout), clock_(std::move(clock)) {
+  if (!builder_) {
+    throw std::invalid_argument("Lazy requires a builder");
+  }
+}
+
+Lazy::~Lazy() {
+  if (pending_.valid()) {
+    pending_.wait();
+  }
+}
+
+Status Lazy::operator()() {
+  preallocate();
+  last_tick_ = tick_time(*clock_);
+  // Report one deadline per idle period rather than one per tick;
+  // release_idle() reports the later expiry of a node ticked meanwhile
+  if (idle_timeout_ > Clock::Duration::zero() &&
+      last_tick_ >= reported_deadline_) {
+    reported_deadline_ = last_tick_ + idle_timeout_;
+    clock_->add_deadline(reported_deadline_);
+  }
+  return tick_child(children_.front());
+}
+
+void Lazy::preallocate() {
+  if (!children_.empty()) {
+    return;
+  }
+  auto subtree = pending_.valid() ? pending_.get() : builder_();
+  if (!subtree) {
+    throw std::runtime_error("Lazy builder of '" + description() +
+                             "' returned no subtree");
+  }
+  children_.push_back(std::move(subtree));
+}
+
+void Lazy::prewarm() {
+  if (children_.empty() && !pending_.valid()) {
+    pending_ = std::async(std::launch::async, builder_);
+  }
+}
+
+bool Lazy::built() const { return !children_.empty(); }
+
+void Lazy::release() { children_.clear(); }
+
+std::size_t Lazy::release_idle(const BehaviorPtr &root) {
+  std::size_t released = 0;
+  std::unordered_set<const BehaviorNode *> visited;
+  std::vector<BehaviorNode *> pending;
+  if (root) {
+    pending.push_back(root.get());
+  }
+  while (!pending.empty()) {
+    auto *node = pending.back();
+    pending.pop_back();
+    if (!visited.insert(node).second) {
+      continue;
+    }
+    auto *lazy = dynamic_cast<Lazy *>(node);
+    if (lazy && lazy->built() &&
+        lazy->idle_timeout_ > Clock::Duration::zero()) {
+      auto expiry = lazy->last_tick_ + lazy->idle_timeout_;
+      if (lazy->clock_->now() >= expiry) {
+        lazy->release();
+        ++released;
+        continue;
+      }
+      if (expiry > lazy->reported_deadline_) {
+        lazy->reported_deadline_ = expiry;
+        lazy->clock_->add_deadline(expiry);
+      }
+    }
+    for (const auto &child : node->children()) {
+      pending.push_back(child.get());
+    }
+  }
+  return released;
+}
+
+} // namespace evo::behavior
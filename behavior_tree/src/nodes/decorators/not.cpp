@@ -7,7 +7,7 @@ Not::Not(BehaviorPtr child)
 
 Status Not::operator()() {
   auto &child_node = children().front();
-  Status result = (*child_node)();
+  Status result = tick_child(child_node);
   switch (Status::State(result)) {
   case Status::SUCCESS:
     return Status::Failure;
@@ -15,6 +15,8 @@ Status Not::operator()() {
     return Status::Success;
   case Status::RUNNING:
     return Status::Running;
+  case Status::INCOMPLETE:
+    return Status::Incomplete;
   default:
     return Status::Failure; // Default case to handle unexpected status
   }
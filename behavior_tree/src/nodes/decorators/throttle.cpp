@@ -0,0 +1,30 @@
+#include "behavior_tree/nodes/decorators/throttle.h"
+#include "behavior_tree/tick_context.h"
+
+namespace evo::behavior {
+
+Throttle::Throttle(BehaviorPtr child, Clock::Duration period, ClockPtr clock)
+    : BehaviorNode("throttle", "Throttling " + child->description(), child),
+      period_(period), clock_(std::move(clock)) {}
+
+Status Throttle::operator()() {
+  auto now = tick_time(*clock_);
+  if (!ticked_ || now - last_tick_ >= period_) {
+    Status result = tick_child(children().front());
+    if (result == Status::Incomplete) {
+      return result; // Tick the child again on the next call
+    }
+    last_result_ = result;
+    last_tick_ = now;
+    ticked_ = true;
+    clock_->add_deadline(now + period_);
+  }
+  return last_result_;
+}
+
+void Throttle::reset() {
+  BehaviorNode::reset();
+  ticked_ = false;
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,116 @@
+#include "behavior_tree/nodes/dynamic_composite.h"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace evo::behavior {
+
+DynamicComposite::DynamicComposite(const std::string &type,
+                                   const std::string &description,
+                                   const Children &children)
+    : BehaviorNode(type, description, children) {}
+
+DynamicComposite::~DynamicComposite() {
+  auto *change = pending_.exchange(nullptr, std::memory_order_acquire);
+  while (change) {
+    delete std::exchange(change, change->next);
+  }
+}
+
+void DynamicComposite::append(BehaviorPtr child) {
+  if (!child) {
+    throw std::invalid_argument("Cannot append a null child");
+  }
+  submit(new Change{Change::APPEND, std::move(child), nullptr});
+}
+
+void DynamicComposite::remove(BehaviorPtr child) {
+  submit(new Change{Change::REMOVE, std::move(child), nullptr});
+}
+
+void DynamicComposite::replace(BehaviorPtr child, BehaviorPtr replacement) {
+  if (!replacement) {
+    throw std::invalid_argument("Cannot replace a child with null");
+  }
+  submit(new Change{Change::REPLACE, std::move(child), std::move(replacement)});
+}
+
+void DynamicComposite::clear() {
+  submit(new Change{Change::CLEAR, nullptr, nullptr});
+}
+
+void DynamicComposite::consume_finished(bool consume) { consume_ = consume; }
+
+bool DynamicComposite::consumes_finished() const { return consume_; }
+
+void DynamicComposite::submit(Change *change) {
+  change->next = pending_.load(std::memory_order_relaxed);
+  while (!pending_.compare_exchange_weak(change->next, change,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+  }
+}
+
+void DynamicComposite::apply_changes() {
+  if (!pending_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  // Take the whole list and reverse it into submission order
+  Change *change = pending_.exchange(nullptr, std::memory_order_acquire);
+  Change *ordered = nullptr;
+  while (change) {
+    ordered = std::exchange(change, std::exchange(change->next, ordered));
+  }
+
+  while (ordered) {
+    std::unique_ptr<Change> current(std::exchange(ordered, ordered->next));
+    auto find = [&] {
+      return std::find(children_.begin(), children_.end(), current->child);
+    };
+    switch (current->kind) {
+    case Change::APPEND:
+      children_.push_back(std::move(current->child));
+      break;
+    case Change::REMOVE:
+      if (auto child = find(); child != children_.end()) {
+        children_.erase(child);
+      }
+      break;
+    case Change::REPLACE:
+      if (auto child = find(); child != children_.end()) {
+        *child = std::move(current->replacement);
+      }
+      break;
+    case Change::CLEAR:
+      children_.clear();
+      break;
+    }
+  }
+}
+
+Status DynamicComposite::tick_children(const Status &pass_status) {
+  if (resume_child_ == 0) {
+    apply_changes();
+  }
+  for (auto i = resume_child_; i < children_.size();) {
+    Status result = tick_child(children_[i]);
+    if (result == Status::Incomplete) {
+      resume_child_ = i; // Continue from this child on the next tick
+      return result;
+    }
+    if (result != pass_status) {
+      resume_child_ = 0;
+      return result;
+    }
+    if (consume_) {
+      children_.erase(children_.begin() + static_cast<std::ptrdiff_t>(i));
+    } else {
+      ++i;
+    }
+  }
+  resume_child_ = 0;
+  return pass_status;
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,13 @@
+#include "behavior_tree/nodes/dynamic_fallback.h"
+
+namespace evo::behavior {
+
+DynamicFallback::DynamicFallback(const std::string &description,
+                                 const Children &children)
+    : DynamicComposite("dynamic_fallback", description, children) {}
+
+Status DynamicFallback::operator()() {
+  return tick_children(Status::Failure);
+}
+
+} // namespace evo::behavior
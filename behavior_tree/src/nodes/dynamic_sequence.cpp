@@ -0,0 +1,13 @@
+#include "behavior_tree/nodes/dynamic_sequence.h"
+
+namespace evo::behavior {
+
+DynamicSequence::DynamicSequence(const std::string &description,
+                                 const Children &children)
+    : DynamicComposite("dynamic_sequence", description, children) {}
+
+Status DynamicSequence::operator()() {
+  return tick_children(Status::Success);
+}
+
+} // namespace evo::behavior
@@ -1,21 +1,24 @@
 #include "behavior_tree/nodes/fallback.h"
-#include <iostream>
+
 namespace evo::behavior {
 
 Fallback::Fallback(const std::string &description, const Children &children)
     : BehaviorNode("fallback", description, children) {}
 
 Status Fallback::operator()() {
-  int child_index = 0;
-  for (const auto &child : children()) {
-    Status result = (*child)();
-    std::cout << "Child index: " << child_index << ", Status: " << result
-              << std::endl;
+  for (auto child_index = resume_child_; child_index < children().size();
+       ++child_index) {
+    Status result = tick_child(children()[child_index]);
+    if (result == Status::Incomplete) {
+      resume_child_ = child_index; // Continue from this child on the next tick
+      return result;
+    }
     if (result != Status::Failure) {
+      resume_child_ = 0;
       return result; // Early exit if any child succeeds
     }
-    ++child_index;
   }
+  resume_child_ = 0;
   return Status::Failure; // Return failure if no child succeeds
 }
 
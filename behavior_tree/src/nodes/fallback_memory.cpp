@@ -1,4 +1,5 @@
 #include "behavior_tree/nodes/fallback_memory.h"
+#include "behavior_tree/metrics.h"
 
 namespace evo::behavior {
 
@@ -11,21 +12,20 @@ Status FallbackMemory::operator()() {
   // Start from the current child and evaluate until one succeeds or all are
   // evaluated
   while (current_child_ != children().end()) {
-    Status child_status = (**current_child_)();
+    Status child_status = tick_child(*current_child_);
     if (child_status != Status::FAILURE) {
       return child_status;
     }
     current_child_++;
   }
+  library_metrics().add(LibraryMetrics::MEMORY_RESTARTS);
   reset();                // Ensure the next call starts from the first child
   return Status::FAILURE; // All children failed, return Failure
 }
 
 void FallbackMemory::reset() {
+  BehaviorNode::reset(); // Children are reset when they are ticked next time
   current_child_ = children().begin();
-  for (auto const &child : children()) {
-    child->reset(); // Reset each child's state
-  }
 }
 
 } // namespace evo::behavior
@@ -0,0 +1,137 @@
+#include "behavior_tree/nodes/for_each.h"
+#include "behavior_tree/tick_context.h"
+#include "behavior_tree/tick_control.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace evo::behavior {
+
+ForEach::ForEach(const std::string &description, SizeFunction size,
+                 ItemFactory item, ForEachPolicy policy)
+    : BehaviorNode("for_each", description), size_(std::move(size)),
+      item_(std::move(item)), policy_(std::move(policy)) {
+  if (!size_ || !item_) {
+    throw std::invalid_argument("ForEach requires a size and an item factory");
+  }
+  if (policy_.chunk_size == 0) {
+    throw std::invalid_argument("ForEach requires a positive chunk size");
+  }
+}
+
+Status ForEach::operator()() {
+  if (resume_child_ == 0) {
+    count_ = size_();
+    counts_ = {};
+    build_items(count_);
+    if (policy_.pool && count_ >= policy_.parallel_items) {
+      return tick_parallel();
+    }
+  }
+
+  for (auto i = resume_child_; i < count_; ++i) {
+    Status result = tick_child(children_[i]);
+    if (result == Status::Incomplete) {
+      resume_child_ = i; // Continue from this item on the next tick
+      return result;
+    }
+    if (result == Status::Success) {
+      ++counts_.success;
+    } else if (result == Status::Failure) {
+      ++counts_.failure;
+    } else {
+      ++counts_.running;
+    }
+    Status decided = decide(counts_, false);
+    if (decided != Status::Incomplete) {
+      resume_child_ = 0;
+      return decided;
+    }
+  }
+  resume_child_ = 0;
+  return decide(counts_, true);
+}
+
+void ForEach::preallocate() {
+  auto count = size_();
+  build_items(count);
+  if (policy_.pool) {
+    chunk_counts_.reserve((count + policy_.chunk_size - 1) /
+                          policy_.chunk_size);
+  }
+}
+
+void ForEach::build_items(std::size_t count) {
+  while (children_.size() < count) {
+    auto child = item_(children_.size());
+    if (!child) {
+      throw std::invalid_argument("ForEach item factory returned null");
+    }
+    children_.push_back(std::move(child));
+  }
+}
+
+void ForEach::reset() {
+  BehaviorNode::reset(); // Children are reset when they are ticked next time
+  counts_ = {};
+}
+
+Status ForEach::tick_parallel() {
+  auto chunks = (count_ + policy_.chunk_size - 1) / policy_.chunk_size;
+  chunk_counts_.assign(chunks, Counts{});
+  auto *context = TickContext::current();
+  policy_.pool->parallel_for(chunks, [this, context](std::size_t chunk) {
+    // The tick's control and observers are not thread safe
+    TickControl::Scope scope(nullptr);
+    // Neither is the scratch arena of the tick's context
+    auto branched = context ? context->branch() : TickContext();
+    TickContext::Scope context_scope(context ? &branched : nullptr);
+    Counts counts;
+    auto end = std::min(count_, (chunk + 1) * policy_.chunk_size);
+    for (auto i = chunk * policy_.chunk_size; i < end; ++i) {
+      Status result = tick_child(children_[i]);
+      if (result == Status::Success) {
+        ++counts.success;
+      } else if (result == Status::Failure) {
+        ++counts.failure;
+      } else {
+        ++counts.running;
+      }
+    }
+    chunk_counts_[chunk] = counts;
+  });
+
+  Counts total;
+  for (const auto &counts : chunk_counts_) {
+    total.success += counts.success;
+    total.failure += counts.failure;
+    total.running += counts.running;
+  }
+  return decide(total, true);
+}
+
+std::size_t ForEach::required() const {
+  switch (policy_.mode) {
+  case ForEachPolicy::ALL:
+    return count_;
+  case ForEachPolicy::ANY:
+    return 1;
+  default:
+    return policy_.threshold;
+  }
+}
+
+Status ForEach::decide(const Counts &counts, bool complete) const {
+  auto needed = required();
+  if (needed > count_) {
+    return Status::Failure; // Not enough items to ever succeed
+  }
+  if (counts.success >= needed) {
+    return Status::Success;
+  }
+  if (counts.failure > count_ - needed) {
+    return Status::Failure;
+  }
+  return complete ? Status::Running : Status::Incomplete;
+}
+
+} // namespace evo::behavior
@@ -2,20 +2,34 @@
 
 namespace evo::behavior {
 
+namespace {
+
+/// Values of resume_child_ telling which branch an incomplete tick stopped in.
+enum Branch : std::size_t { IF_BRANCH, THEN_BRANCH };
+
+} // namespace
+
 IfThen::IfThen(const std::string &description, BehaviorPtr if_node,
                BehaviorPtr then_node)
-    : BehaviorNode("if_then", description), if_node_(std::move(if_node)),
-      then_node_(std::move(then_node)) {}
+    : BehaviorNode("if_then", description, std::move(if_node),
+                   std::move(then_node)) {}
 
 Status IfThen::operator()() {
-  Status condition_status = (*if_node_)();
-  if (condition_status == Status::Success) {
-    return (*then_node_)();
-  }
-  if (condition_status == Status::Running) {
-    return Status::Running;
+  if (resume_child_ == IF_BRANCH) {
+    Status condition_status = tick_child(children()[IF_BRANCH]);
+    if (condition_status == Status::Incomplete) {
+      return Status::Incomplete;
+    }
+    if (condition_status == Status::Running) {
+      return Status::Running;
+    }
+    if (condition_status == Status::Failure) {
+      return Status::Success; // Returns success if the condition is not met
+    }
   }
-  return Status::Success; // Returns success if the condition is not met
+  Status then_status = tick_child(children()[THEN_BRANCH]);
+  resume_child_ = then_status == Status::Incomplete ? THEN_BRANCH : IF_BRANCH;
+  return then_status;
 }
 
 } // namespace evo::behavior
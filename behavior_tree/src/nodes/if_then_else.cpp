@@ -2,20 +2,35 @@
 
 namespace evo::behavior {
 
+namespace {
+
+/// Values of resume_child_ telling which branch an incomplete tick stopped in.
+enum Branch : std::size_t { IF_BRANCH, THEN_BRANCH, ELSE_BRANCH };
+
+} // namespace
+
 IfThenElse::IfThenElse(const std::string &description, BehaviorPtr if_node,
                        BehaviorPtr then_node, BehaviorPtr else_node)
-    : BehaviorNode("if_then_else", description), if_node_(std::move(if_node)),
-      then_node_(std::move(then_node)), else_node_(std::move(else_node)) {}
+    : BehaviorNode("if_then_else", description, std::move(if_node),
+                   std::move(then_node), std::move(else_node)) {}
 
 Status IfThenElse::operator()() {
-  Status condition_status = (*if_node_)();
-  if (condition_status == Status::Success) {
-    return (*then_node_)();
-  } else if (condition_status == Status::Failure) {
-    return (*else_node_)();
-  } else {
-    return Status::Running;
+  auto branch = static_cast<Branch>(resume_child_);
+  if (branch == IF_BRANCH) {
+    Status condition_status = tick_child(children()[IF_BRANCH]);
+    if (condition_status == Status::Success) {
+      branch = THEN_BRANCH;
+    } else if (condition_status == Status::Failure) {
+      branch = ELSE_BRANCH;
+    } else if (condition_status == Status::Incomplete) {
+      return Status::Incomplete;
+    } else {
+      return Status::Running;
+    }
   }
+  Status result = tick_child(children()[branch]);
+  resume_child_ = result == Status::Incomplete ? branch : IF_BRANCH;
+  return result;
 }
 
 } // namespace evo::behavior
@@ -9,15 +9,25 @@ Latch::Latch(BehaviorPtr child, bool latched)
 Status Latch::operator()() {
   if (!latched_) {
     auto &child_node = children().front();
-    last_result_ = (*child_node)();
+    Status result = tick_child(child_node);
+    if (result == Status::Incomplete) {
+      return result; // Latch only once the child has completed its tick
+    }
+    last_result_ = result;
     latched_ = true; // Latch after the first successful execution
   }
   return last_result_;
 }
 
-BehaviorPtr Latch::make_unlatcher() {
-  return std::make_shared<Action>([this] { latched_ = false; },
-                                  "Unlatching " + description());
-}
+BehaviorPtr Latch::make_unlatcher() { return std::make_shared<Unlatch>(*this); }
+
+void Latch::unlatch() { latched_ = false; }
+
+Unlatch::Unlatch(Latch &latch)
+    : Action([&latch] { latch.unlatch(); },
+             "Unlatching " + latch.description()),
+      latch_(&latch) {}
+
+Latch &Unlatch::latch() const { return *latch_; }
 
 } // namespace evo::behavior
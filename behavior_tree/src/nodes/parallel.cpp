@@ -6,17 +6,25 @@ Parallel::Parallel(const std::string &description, const Children &children)
     : BehaviorNode("parallel", description, children) {}
 
 Status Parallel::operator()() {
-  bool all_success = true;
-  for (const auto &child : children()) {
-    Status result = (*child)();
+  if (resume_child_ == 0) {
+    all_success_ = true;
+  }
+  for (auto i = resume_child_; i < children().size(); ++i) {
+    Status result = tick_child(children()[i]);
+    if (result == Status::Incomplete) {
+      resume_child_ = i; // Continue from this child on the next tick
+      return result;
+    }
     if (result == Status::Running) {
+      resume_child_ = 0;
       return Status::Running; // Immediate return if any child is running
     }
     if (result == Status::Failure) {
-      all_success = false; // Mark failure but continue evaluating all children
+      all_success_ = false; // Mark failure but continue evaluating all children
     }
   }
-  return all_success ? Status::Success : Status::Failure;
+  resume_child_ = 0;
+  return all_success_ ? Status::Success : Status::Failure;
 }
 
 } // namespace evo::behavior
@@ -0,0 +1,90 @@
+#include "behavior_tree/nodes/procedural_composite.h"
+#include "behavior_tree/metrics.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace evo::behavior {
+
+ProceduralComposite::ProceduralComposite(const std::string &type,
+                                         const std::string &description,
+                                         std::size_t count, Generator generator,
+                                         std::size_t window)
+    : BehaviorNode(type, description), count_(count),
+      generator_(std::move(generator)), window_(window) {
+  if (!generator_) {
+    throw std::invalid_argument("ProceduralComposite requires a generator");
+  }
+  if (window_ == 0) {
+    throw std::invalid_argument("ProceduralComposite requires a window");
+  }
+}
+
+std::size_t ProceduralComposite::size() const { return count_; }
+
+BehaviorPtr ProceduralComposite::child(std::size_t index) const {
+  if (index >= count_) {
+    throw std::out_of_range("Node has no child at index " +
+                            std::to_string(index));
+  }
+  return generator_(index, nullptr);
+}
+
+std::size_t ProceduralComposite::current() const { return current_; }
+
+void ProceduralComposite::reset() {
+  BehaviorNode::reset(); // Children are reset when they are ticked next time
+  current_ = 0;
+}
+
+void ProceduralComposite::preallocate() {
+  for (auto i = current_; i < std::min(count_, current_ + window_); ++i) {
+    instantiate(i);
+  }
+}
+
+Status ProceduralComposite::tick_children(const Status &pass_status) {
+  for (; current_ < count_; ++current_) {
+    Status result = tick_child(instantiate(current_));
+    if (result != pass_status) {
+      // Return running, incomplete or the other terminal status immediately
+      return result;
+    }
+  }
+  // All children passed; start over with the first one on the next run
+  library_metrics().add(LibraryMetrics::MEMORY_RESTARTS);
+  reset();
+  return pass_status;
+}
+
+const BehaviorPtr &ProceduralComposite::instantiate(std::size_t index) {
+  auto found = std::find(indices_.begin(), indices_.end(), index);
+  if (found != indices_.end()) {
+    return children_[static_cast<std::size_t>(found - indices_.begin())];
+  }
+
+  if (children_.size() >= window_) {
+    // Evict the least recently instantiated child
+    auto evicted = std::move(children_.front());
+    children_.erase(children_.begin());
+    indices_.erase(indices_.begin());
+    if (pool_.size() < window_) {
+      evicted->reset();
+      pool_.push_back(std::move(evicted));
+    }
+  }
+  BehaviorPtr recycled;
+  if (!pool_.empty()) {
+    recycled = std::move(pool_.back());
+    pool_.pop_back();
+  }
+  auto child = generator_(index, std::move(recycled));
+  if (!child) {
+    throw std::invalid_argument("Generator returned no subtree for child " +
+                                std::to_string(index));
+  }
+  children_.push_back(std::move(child));
+  indices_.push_back(index);
+  return children_.back();
+}
+
+} // namespace evo::behavior
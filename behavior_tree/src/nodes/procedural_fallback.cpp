@@ -0,0 +1,15 @@
+#include "behavior_tree/nodes/procedural_fallback.h"
+
+namespace evo::behavior {
+
+ProceduralFallback::ProceduralFallback(const std::string &description,
+                                       std::size_t count, Generator generator,
+                                       std::size_t window)
+    : ProceduralComposite("procedural_fallback", description, count,
+                          std::move(generator), window) {}
+
+Status ProceduralFallback::operator()() {
+  return tick_children(Status::Failure);
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,15 @@
+#include "behavior_tree/nodes/procedural_sequence.h"
+
+namespace evo::behavior {
+
+ProceduralSequence::ProceduralSequence(const std::string &description,
+                                       std::size_t count, Generator generator,
+                                       std::size_t window)
+    : ProceduralComposite("procedural_sequence", description, count,
+                          std::move(generator), window) {}
+
+Status ProceduralSequence::operator()() {
+  return tick_children(Status::Success);
+}
+
+} // namespace evo::behavior
@@ -6,12 +6,18 @@ Sequence::Sequence(const std::string &description, const Children &children)
     : BehaviorNode("sequence", description, children) {}
 
 Status Sequence::operator()() {
-  for (auto &child : children()) {
-    Status result = (*child)();
+  for (auto i = resume_child_; i < children().size(); ++i) {
+    Status result = tick_child(children()[i]);
+    if (result == Status::Incomplete) {
+      resume_child_ = i; // Continue from this child on the next tick
+      return result;
+    }
     if (result != Status::Success) {
+      resume_child_ = 0;
       return result;
     }
   }
+  resume_child_ = 0;
   return Status::Success; // All children succeeded
 }
 
@@ -1,5 +1,5 @@
 #include "behavior_tree/nodes/sequence_memory.h"
-#include <iostream>
+#include "behavior_tree/metrics.h"
 
 namespace evo::behavior {
 
@@ -10,8 +10,7 @@ SequenceMemory::SequenceMemory(const std::string &description,
 
 Status SequenceMemory::operator()() {
   for (; current_child_ != children().end(); ++current_child_) {
-    Status child_status = (**current_child_)();
-    std::cout << child_status << std::endl;
+    Status child_status = tick_child(*current_child_);
     if (child_status != Status::SUCCESS) {
       // Return running or failure immediately
       return child_status;
@@ -19,15 +18,14 @@ Status SequenceMemory::operator()() {
   }
   // If all children succeeded and we reached the end, reset for the next run
   // and return success
+  library_metrics().add(LibraryMetrics::MEMORY_RESTARTS);
   reset();
   return Status::SUCCESS;
 }
 
 void SequenceMemory::reset() {
+  BehaviorNode::reset(); // Children are reset when they are ticked next time
   current_child_ = children().begin();
-  for (auto const &child : children()) {
-    child->reset();
-  }
 }
 
 } // namespace evo::behavior
@@ -6,12 +6,18 @@ Skipper::Skipper(const std::string &description, const Children &children)
     : BehaviorNode("skipper", description, children) {}
 
 Status Skipper::operator()() {
-  for (const auto &child : children()) {
-    Status result = (*child)();
+  for (auto i = resume_child_; i < children().size(); ++i) {
+    Status result = tick_child(children()[i]);
+    if (result == Status::Incomplete) {
+      resume_child_ = i; // Continue from this child on the next tick
+      return result;
+    }
     if (result != Status::Running) {
+      resume_child_ = 0;
       return result;
     }
   }
+  resume_child_ = 0;
   return Status::Running; // Return running if all children are running, else
                           // return failure
 }
@@ -64,6 +64,9 @@ std::ostream &operator<<(std::ostream &os, const Status &status) {
   case Status::RUNNING:
     os << "RUNNING";
     break;
+  case Status::INCOMPLETE:
+    os << "INCOMPLETE";
+    break;
   default:
     os << "UNKNOWN";
   }
@@ -74,5 +77,6 @@ std::ostream &operator<<(std::ostream &os, const Status &status) {
 const Status Status::Success(Status::SUCCESS);
 const Status Status::Failure(Status::FAILURE);
 const Status Status::Running(Status::RUNNING);
+const Status Status::Incomplete(Status::INCOMPLETE);
 
 } // namespace evo::behavior
@@ -2,22 +2,35 @@
 #include "behavior_tree/nodes/status.h" // Ensure the Status class is included correctly
 namespace evo::behavior {
 
+namespace {
+
+/// Values of resume_child_ telling which branch an incomplete tick stopped in.
+enum Branch : std::size_t { TRY_BRANCH, ELSE_BRANCH };
+
+} // namespace
+
 TryElse::TryElse(const std::string &description, BehaviorPtr try_node,
                  BehaviorPtr else_node)
-    : BehaviorNode("try_else", description, try_node, else_node),
-      try_node_(try_node), else_node_(else_node) {}
+    : BehaviorNode("try_else", description, std::move(try_node),
+                   std::move(else_node)) {}
 
 Status TryElse::operator()() {
-  Status try_status = (*try_node_)();
-  if (try_status == Status::Success) {
-    return Status::Success; // Return success immediately if try_node succeeds
-  }
-  if (try_status == Status::Running) {
-    return Status::Running; // Return running if the try_node is still in
-                            // progress
+  if (resume_child_ == TRY_BRANCH) {
+    Status try_status = tick_child(children()[TRY_BRANCH]);
+    if (try_status == Status::Success) {
+      return Status::Success; // Return success immediately if try_node succeeds
+    }
+    if (try_status == Status::Running || try_status == Status::Incomplete) {
+      return try_status; // Return if the try_node is still in progress
+    }
   }
   // Execute else_node if try_node fails
-  Status else_status = (*else_node_)();
+  Status else_status = tick_child(children()[ELSE_BRANCH]);
+  if (else_status == Status::Incomplete) {
+    resume_child_ = ELSE_BRANCH; // Skip the try_node on the next tick
+    return else_status;
+  }
+  resume_child_ = TRY_BRANCH;
   if (else_status == Status::Running) {
     return Status::Running; // Return running if the else_node is still in
                             // progress
@@ -0,0 +1,110 @@
+#include "behavior_tree/nodes/unordered_composite.h"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+
+namespace evo::behavior {
+
+namespace {
+
+/// Lower bound for the stop rate, keeps ranks of never stopping children finite.
+constexpr double min_stop_rate = 1e-3;
+
+} // namespace
+
+UnorderedComposite::UnorderedComposite(const std::string &type,
+                                       const std::string &description,
+                                       const Children &children,
+                                       double smoothing)
+    : BehaviorNode(type, description, children), smoothing_(smoothing),
+      order_(children.size()), stats_(children.size()) {
+  std::iota(order_.begin(), order_.end(), 0);
+}
+
+const std::vector<std::size_t> &UnorderedComposite::order() const {
+  return order_;
+}
+
+void UnorderedComposite::set_order(const std::vector<std::size_t> &order) {
+  auto sorted = order;
+  std::sort(sorted.begin(), sorted.end());
+  bool is_permutation = sorted.size() == children().size();
+  for (std::size_t i = 0; is_permutation && i < sorted.size(); ++i) {
+    is_permutation = sorted[i] == i;
+  }
+  if (!is_permutation) {
+    throw std::invalid_argument("Order of '" + description() +
+                                "' must be a permutation of its children");
+  }
+  order_ = order;
+}
+
+const std::vector<UnorderedComposite::ChildStats> &
+UnorderedComposite::stats() const {
+  return stats_;
+}
+
+void UnorderedComposite::freeze(bool frozen) { frozen_ = frozen; }
+
+bool UnorderedComposite::frozen() const { return frozen_; }
+
+Status UnorderedComposite::tick_in_order(const Status &pass_status) {
+  Status result = pass_status;
+  for (auto position = resume_child_; position < order_.size(); ++position) {
+    auto index = order_[position];
+    auto start = std::chrono::steady_clock::now();
+    result = tick_child(children()[index]);
+    std::chrono::duration<double, std::nano> cost =
+        std::chrono::steady_clock::now() - start;
+    if (result == Status::Incomplete) {
+      // Keep the order until the tick is complete
+      resume_child_ = position;
+      return result;
+    }
+
+    bool stopped = result != pass_status;
+    auto &stats = stats_[index];
+    if (stats.samples == 0) {
+      stats.cost = cost.count();
+      stats.stop_rate = stopped ? 1.0 : 0.0;
+    } else {
+      stats.cost += smoothing_ * (cost.count() - stats.cost);
+      stats.stop_rate += smoothing_ * ((stopped ? 1.0 : 0.0) - stats.stop_rate);
+    }
+    ++stats.samples;
+
+    if (stopped) {
+      break;
+    }
+  }
+  resume_child_ = 0;
+  if (!frozen_) {
+    reorder();
+  }
+  return result;
+}
+
+void UnorderedComposite::reorder() {
+  auto rank = [this](std::size_t index) {
+    const auto &stats = stats_[index];
+    return stats.cost / std::max(stats.stop_rate, min_stop_rate);
+  };
+  // Insertion sort: the order barely changes between ticks
+  for (std::size_t i = 1; i < order_.size(); ++i) {
+    auto index = order_[i];
+    auto index_rank = rank(index);
+    auto j = i;
+    for (; j > 0; --j) {
+      auto previous_rank = rank(order_[j - 1]);
+      if (previous_rank < index_rank ||
+          (previous_rank == index_rank && order_[j - 1] < index)) {
+        break;
+      }
+      order_[j] = order_[j - 1];
+    }
+    order_[j] = index;
+  }
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,13 @@
+#include "behavior_tree/nodes/unordered_fallback.h"
+
+namespace evo::behavior {
+
+UnorderedFallback::UnorderedFallback(const std::string &description,
+                                     const Children &children)
+    : UnorderedComposite("unordered_fallback", description, children) {}
+
+Status UnorderedFallback::operator()() {
+  return tick_in_order(Status::Failure);
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,13 @@
+#include "behavior_tree/nodes/unordered_sequence.h"
+
+namespace evo::behavior {
+
+UnorderedSequence::UnorderedSequence(const std::string &description,
+                                     const Children &children)
+    : UnorderedComposite("unordered_sequence", description, children) {}
+
+Status UnorderedSequence::operator()() {
+  return tick_in_order(Status::Success);
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,142 @@
+#include "behavior_tree/perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace evo::behavior {
+
+namespace {
+
+#ifdef __linux__
+/// Hardware event configurations, indexed by PerfCounters::Event.
+constexpr std::uint64_t event_configs[PerfCounters::EVENT_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+/// Opens a user space hardware counter of the calling thread.
+int open_event(std::uint64_t config, int group) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = group == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+#endif
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+#ifdef __linux__
+  for (int event = 0; event < EVENT_COUNT; ++event) {
+    fds_[event] = open_event(event_configs[event], leader_);
+    if (leader_ == -1) {
+      leader_ = fds_[event];
+    }
+  }
+  if (leader_ != -1) {
+    ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+  for (auto fd : fds_) {
+    if (fd != -1) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+bool PerfCounters::available() const { return leader_ != -1; }
+
+std::vector<PerfCounters::Event> PerfCounters::events() const {
+  std::vector<Event> events;
+  for (int event = 0; event < EVENT_COUNT; ++event) {
+    if (fds_[event] != -1) {
+      events.push_back(static_cast<Event>(event));
+    }
+  }
+  return events;
+}
+
+std::string PerfCounters::name(Event event) {
+  switch (event) {
+  case CYCLES:
+    return "cycles";
+  case INSTRUCTIONS:
+    return "instructions";
+  case CACHE_MISSES:
+    return "cache_misses";
+  case BRANCH_MISSES:
+    return "branch_misses";
+  default:
+    return "unknown";
+  }
+}
+
+const std::unordered_map<const BehaviorNode *, PerfCounters::NodeCounters> &
+PerfCounters::nodes() const {
+  return nodes_;
+}
+
+void PerfCounters::clear() { nodes_.clear(); }
+
+void PerfCounters::on_enter(const BehaviorNode &) {
+  stack_.push_back({{}, {}});
+  stack_.back().start = read();
+}
+
+void PerfCounters::on_exit(const BehaviorNode &node, Status) {
+  auto end = read();
+  auto frame = stack_.back();
+  stack_.pop_back();
+
+  auto &counters = nodes_[&node];
+  ++counters.ticks;
+  for (int event = 0; event < EVENT_COUNT; ++event) {
+    auto inclusive = end[event] - frame.start[event];
+    counters.inclusive[event] += inclusive;
+    counters.exclusive[event] += inclusive - frame.children[event];
+    if (!stack_.empty()) {
+      stack_.back().children[event] += inclusive;
+    }
+  }
+}
+
+PerfCounters::Counts PerfCounters::read() const {
+  Counts counts{};
+#ifdef __linux__
+  if (leader_ == -1) {
+    return counts;
+  }
+  // Group format: the number of events followed by their values
+  std::uint64_t buffer[1 + EVENT_COUNT] = {};
+  if (::read(leader_, buffer, sizeof(buffer)) <= 0) {
+    return counts;
+  }
+  std::uint64_t value = 0;
+  for (int event = 0; event < EVENT_COUNT && value < buffer[0]; ++event) {
+    if (fds_[event] != -1) {
+      counts[event] = buffer[1 + value++];
+    }
+  }
+#endif
+  return counts;
+}
+
+} // namespace evo::behavior
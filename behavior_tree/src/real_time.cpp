@@ -0,0 +1,94 @@
+#include "behavior_tree/real_time.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace evo::behavior {
+
+namespace {
+
+/// The guard installed for the current thread.
+thread_local AllocationGuard *current_guard = nullptr;
+
+/**
+ * @brief Writes to every page of a stack buffer of the given size.
+ *
+ * @param bytes The size of the buffer.
+ */
+void prefault_stack(std::size_t bytes) {
+  constexpr std::size_t chunk = 16 * 1024;
+  volatile unsigned char buffer[chunk];
+  for (std::size_t i = 0; i < chunk; i += 512) {
+    buffer[i] = 0;
+  }
+  if (bytes > chunk) {
+    prefault_stack(bytes - chunk);
+  }
+  buffer[0] = buffer[0]; // Keeps the frame alive across the recursive call
+}
+
+} // namespace
+
+AllocationGuard::AllocationGuard(Action action)
+    : action_(action), previous_(current_guard) {
+  current_guard = this;
+}
+
+AllocationGuard::~AllocationGuard() { current_guard = previous_; }
+
+std::uint64_t AllocationGuard::allocations() const { return allocations_; }
+
+void AllocationGuard::record() {
+  auto *guard = current_guard;
+  if (!guard) {
+    return;
+  }
+  ++guard->allocations_;
+  if (guard->action_ == ABORT) {
+    // Formatting the message must not allocate again
+    static const char message[] =
+        "behavior_tree: heap allocation during a real-time tick\n";
+    [[maybe_unused]] auto written =
+        write(STDERR_FILENO, message, sizeof(message) - 1);
+    std::abort();
+  }
+}
+
+bool AllocationGuard::available() {
+  AllocationGuard guard(COUNT);
+  ::operator delete(::operator new(1));
+  return guard.allocations() > 0;
+}
+
+bool prepare_real_time_memory(const RealTimePolicy &policy) {
+  bool locked = true;
+  if (policy.lock_memory) {
+    locked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+  }
+  if (policy.prefault_heap > 0) {
+#ifdef __GLIBC__
+    // Keep freed memory in the heap instead of returning it to the system
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+    auto *heap = static_cast<unsigned char *>(std::malloc(policy.prefault_heap));
+    if (heap) {
+      auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+      for (std::size_t i = 0; i < policy.prefault_heap; i += page) {
+        heap[i] = 0;
+      }
+      std::free(heap);
+    }
+  }
+  if (policy.prefault_stack > 0) {
+    prefault_stack(policy.prefault_stack);
+  }
+  return locked;
+}
+
+} // namespace evo::behavior
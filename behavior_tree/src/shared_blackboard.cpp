@@ -0,0 +1,136 @@
+#include "behavior_tree/shared_blackboard.h"
+#include <algorithm>
+#include <new>
+
+namespace evo::behavior {
+
+namespace {
+
+/// Identifies segments written by SharedBlackboard.
+constexpr char segment_magic[8] = "EVOBTBB";
+/// The version of the segment format.
+constexpr std::uint32_t segment_version = 1;
+/// The size of a cache line, which slots do not share.
+constexpr std::size_t line_size = 64;
+
+/// The start of the segment, followed by the slots and the slot table.
+struct SegmentHeader {
+  /// segment_magic.
+  char magic[8];
+  /// segment_version.
+  std::uint32_t version;
+  /// The number of slots.
+  std::uint32_t slot_count;
+  /// The size of the segment.
+  std::uint64_t size;
+  /// Position and size of the slot table.
+  std::uint64_t table_offset;
+  std::uint64_t table_size;
+};
+
+static_assert(sizeof(SegmentHeader) <= line_size,
+              "The header must fit before the first slot");
+
+std::size_t align(std::size_t offset, std::size_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+void append(std::vector<char> &out, const void *data, std::size_t size) {
+  const auto *bytes = static_cast<const char *>(data);
+  out.insert(out.end(), bytes, bytes + size);
+}
+
+} // namespace
+
+std::size_t BlackboardLayout::add(const std::string &name, std::size_t size,
+                                  std::size_t align_to,
+                                  std::size_t value_offset) {
+  for (const auto &slot : slots_) {
+    if (slot.name == name) {
+      throw std::invalid_argument("Duplicate blackboard slot '" + name + "'");
+    }
+  }
+  auto offset = align(size_, line_size);
+  slots_.push_back({name, static_cast<std::uint32_t>(size),
+                    static_cast<std::uint32_t>(align_to), offset});
+  size_ = offset + value_offset + size;
+  return offset;
+}
+
+SharedBlackboard::SharedBlackboard(const std::string &name,
+                                   const BlackboardLayout &layout)
+    : name_(name), slots_(layout.slots()) {
+  std::vector<char> table;
+  for (const auto &slot : slots_) {
+    auto length = static_cast<std::uint32_t>(slot.name.size());
+    append(table, &length, sizeof(length));
+    append(table, slot.name.data(), slot.name.size());
+    append(table, &slot.size, sizeof(slot.size));
+    append(table, &slot.align, sizeof(slot.align));
+    append(table, &slot.offset, sizeof(slot.offset));
+  }
+  auto table_offset = align(layout.size_, line_size);
+  segment_ = SharedSegment::create(name_, table_offset + table.size());
+
+  // The segment is zero filled, so the locks and values start out zero
+  auto *bytes = segment_.data();
+  for (const auto &slot : slots_) {
+    new (bytes + slot.offset) SeqLock;
+  }
+  auto *header = new (bytes) SegmentHeader{};
+  header->version = segment_version;
+  header->slot_count = static_cast<std::uint32_t>(slots_.size());
+  header->size = segment_.size();
+  header->table_offset = table_offset;
+  header->table_size = table.size();
+  std::memcpy(bytes + table_offset, table.data(), table.size());
+  segment_.publish(segment_magic);
+}
+
+SharedBlackboard::SharedBlackboard(const std::string &name)
+    : name_(name),
+      segment_(SharedSegment::open(name, true, line_size, "blackboard")) {
+  const auto *bytes = segment_.data();
+  const auto *header = reinterpret_cast<const SegmentHeader *>(bytes);
+  bool valid = segment_.published(segment_magic) &&
+               header->version == segment_version &&
+               header->size == segment_.size() &&
+               header->table_offset + header->table_size <= segment_.size();
+  if (!valid) {
+    throw std::runtime_error("Not a blackboard segment: " + name_);
+  }
+  SegmentParser parser(bytes + header->table_offset, header->table_size,
+                       "blackboard slot table");
+  slots_.resize(header->slot_count);
+  for (auto &slot : slots_) {
+    slot.name = parser.text();
+    slot.size = parser.number<std::uint32_t>();
+    slot.align = parser.number<std::uint32_t>();
+    slot.offset = parser.number<std::uint64_t>();
+    auto value_offset = std::max<std::size_t>(slot.align, sizeof(SeqLock));
+    if (slot.offset % line_size != 0 ||
+        slot.offset + value_offset + slot.size > header->table_offset) {
+      throw std::runtime_error("Invalid blackboard slot '" + slot.name +
+                               "' in " + name_);
+    }
+  }
+}
+
+SharedBlackboard::~SharedBlackboard() = default;
+
+const std::vector<BlackboardLayout::SlotInfo> &
+SharedBlackboard::slots() const {
+  return slots_;
+}
+
+const BlackboardLayout::SlotInfo &
+SharedBlackboard::find(const std::string &name) const {
+  auto slot = std::find_if(slots_.begin(), slots_.end(),
+                           [&](const auto &info) { return info.name == name; });
+  if (slot == slots_.end()) {
+    throw std::out_of_range("No blackboard slot '" + name + "' in " + name_);
+  }
+  return *slot;
+}
+
+} // namespace evo::behavior
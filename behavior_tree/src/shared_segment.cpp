@@ -0,0 +1,130 @@
+#include "behavior_tree/shared_segment.h"
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace evo::behavior {
+
+SharedSegment SharedSegment::create(const std::string &name,
+                                    std::size_t size) {
+  int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+  if (fd == -1) {
+    throw std::system_error(errno, std::generic_category(), "shm_open");
+  }
+  if (ftruncate(fd, static_cast<off_t>(size)) == -1) {
+    auto error = errno;
+    close(fd);
+    shm_unlink(name.c_str());
+    throw std::system_error(error, std::generic_category(), "ftruncate");
+  }
+  auto *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // close() and shm_unlink() may overwrite errno
+  auto error = errno;
+  close(fd);
+  if (data == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    throw std::system_error(error, std::generic_category(), "mmap");
+  }
+  SharedSegment segment;
+  segment.name_ = name;
+  segment.data_ = static_cast<char *>(data);
+  segment.size_ = size;
+  segment.owner_ = true;
+  return segment;
+}
+
+SharedSegment SharedSegment::open(const std::string &name, bool writable,
+                                  std::size_t min_size,
+                                  const std::string &kind) {
+  int fd = shm_open(name.c_str(), writable ? O_RDWR : O_RDONLY, 0);
+  if (fd == -1) {
+    throw std::system_error(errno, std::generic_category(), "shm_open");
+  }
+  struct stat info;
+  if (fstat(fd, &info) == -1) {
+    auto error = errno;
+    close(fd);
+    throw std::system_error(error, std::generic_category(), "fstat");
+  }
+  auto size = static_cast<std::size_t>(info.st_size);
+  if (size < min_size) {
+    close(fd);
+    throw std::runtime_error("Not a " + kind + " segment: " + name);
+  }
+  auto *data = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                    MAP_SHARED, fd, 0);
+  auto error = errno;
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::system_error(error, std::generic_category(), "mmap");
+  }
+  SharedSegment segment;
+  segment.name_ = name;
+  segment.data_ = static_cast<char *>(data);
+  segment.size_ = size;
+  return segment;
+}
+
+SharedSegment::SharedSegment(SharedSegment &&other) noexcept
+    : name_(std::move(other.name_)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      owner_(std::exchange(other.owner_, false)) {}
+
+SharedSegment &SharedSegment::operator=(SharedSegment &&other) noexcept {
+  if (this != &other) {
+    release();
+    name_ = std::move(other.name_);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    owner_ = std::exchange(other.owner_, false);
+  }
+  return *this;
+}
+
+SharedSegment::~SharedSegment() { release(); }
+
+void SharedSegment::publish(const char (&magic)[magic_size]) {
+  // Readers check the magic last
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(data_, magic, magic_size);
+}
+
+bool SharedSegment::published(const char (&magic)[magic_size]) const {
+  bool valid = std::memcmp(data_, magic, magic_size) == 0;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return valid;
+}
+
+void SharedSegment::release() {
+  if (!data_) {
+    return;
+  }
+  munmap(data_, size_);
+  if (owner_) {
+    shm_unlink(name_.c_str());
+  }
+  data_ = nullptr;
+}
+
+std::string SegmentParser::text() {
+  auto length = number<std::uint32_t>();
+  return std::string(take(length), length);
+}
+
+const char *SegmentParser::take(std::size_t size) {
+  if (size > size_ - position_) {
+    throw std::runtime_error("Truncated " + section_);
+  }
+  auto *data = data_ + position_;
+  position_ += size;
+  return data;
+}
+
+} // namespace evo::behavior
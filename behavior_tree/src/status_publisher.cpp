@@ -0,0 +1,211 @@
+#include "behavior_tree/status_publisher.h"
+#include "behavior_tree/seqlock.h"
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace evo::behavior {
+
+namespace {
+
+/// Identifies segments written by StatusPublisher.
+constexpr char segment_magic[8] = "EVOBTST";
+/// The version of the segment format.
+constexpr std::uint32_t segment_version = 1;
+
+/// The start of the segment.
+struct SegmentHeader {
+  /// segment_magic.
+  char magic[8];
+  /// segment_version.
+  std::uint32_t version;
+  /// The number of nodes.
+  std::uint32_t node_count;
+  /// The size of the segment.
+  std::uint64_t size;
+  /// Position and size of the topology section.
+  std::uint64_t topology_offset;
+  std::uint64_t topology_size;
+  /// Position of the packed statuses.
+  std::uint64_t statuses_offset;
+  /// Position of the last tick numbers.
+  std::uint64_t last_ticks_offset;
+  /// Protects tick and the state sections.
+  SeqLock lock;
+  /// The number of the published tick.
+  std::uint64_t tick;
+};
+
+std::size_t align(std::size_t offset) { return (offset + 7) & ~std::size_t(7); }
+
+std::size_t packed_size(std::size_t node_count) {
+  return (node_count + 3) / 4;
+}
+
+void append(std::vector<char> &out, std::uint32_t value) {
+  const auto *bytes = reinterpret_cast<const char *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(value));
+}
+
+void append(std::vector<char> &out, const std::string &text) {
+  append(out, static_cast<std::uint32_t>(text.size()));
+  out.insert(out.end(), text.begin(), text.end());
+}
+
+} // namespace
+
+StatusPublisher::StatusPublisher(const std::string &name,
+                                 const BehaviorPtr &root)
+    : StatusPublisher(name, root ? std::make_shared<NodeIndex>(root)
+                                 : nullptr) {}
+
+StatusPublisher::StatusPublisher(const std::string &name,
+                                 std::shared_ptr<const NodeIndex> index)
+    : index_(std::move(index)) {
+  if (!index_ || index_->size() == 0) {
+    throw std::invalid_argument("StatusPublisher requires a root node");
+  }
+
+  std::vector<char> topology;
+  std::vector<std::uint32_t> children;
+  for (std::uint32_t id = 0; id < index_->size(); ++id) {
+    auto node = index_->node(id);
+    children.clear();
+    if (node) {
+      for (const auto &child : node->children()) {
+        // Children added since the nodes were numbered are not published
+        if (auto child_id = index_->find(*child)) {
+          children.push_back(*child_id);
+        }
+      }
+    }
+    append(topology, static_cast<std::uint32_t>(children.size()));
+    for (auto child_id : children) {
+      append(topology, child_id);
+    }
+    append(topology, node ? node->type() : std::string());
+    append(topology, node ? node->description() : std::string());
+  }
+
+  auto node_count = index_->size();
+  statuses_.assign(packed_size(node_count), 0);
+  last_ticks_.assign(node_count, 0);
+  auto topology_offset = align(sizeof(SegmentHeader));
+  auto statuses_offset = align(topology_offset + topology.size());
+  auto last_ticks_offset = align(statuses_offset + statuses_.size());
+  segment_ = SharedSegment::create(
+      name, last_ticks_offset + last_ticks_.size() * sizeof(std::uint64_t));
+
+  auto *bytes = segment_.data();
+  auto *header = new (bytes) SegmentHeader{};
+  header->node_count = static_cast<std::uint32_t>(node_count);
+  header->size = segment_.size();
+  header->topology_offset = topology_offset;
+  header->topology_size = topology.size();
+  header->statuses_offset = statuses_offset;
+  header->last_ticks_offset = last_ticks_offset;
+  header->version = segment_version;
+  std::memcpy(bytes + topology_offset, topology.data(), topology.size());
+  segment_.publish(segment_magic);
+}
+
+StatusPublisher::~StatusPublisher() = default;
+
+std::uint64_t StatusPublisher::tick() const { return tick_; }
+
+void StatusPublisher::on_enter(const BehaviorNode &) {
+  if (depth_++ == 0) {
+    ++tick_;
+  }
+}
+
+void StatusPublisher::on_exit(const BehaviorNode &node, Status status) {
+  if (auto id = index_->find(node)) {
+    auto shift = (*id % 4) * 2;
+    auto &packed = statuses_[*id / 4];
+    packed = static_cast<std::uint8_t>(
+        (packed & ~(3u << shift)) |
+        (static_cast<unsigned>(Status::State(status)) << shift));
+    last_ticks_[*id] = tick_;
+  }
+  if (depth_ > 0 && --depth_ == 0) {
+    publish();
+  }
+}
+
+void StatusPublisher::publish() {
+  auto *bytes = segment_.data();
+  auto *header = reinterpret_cast<SegmentHeader *>(bytes);
+  header->lock.write([&] {
+    header->tick = tick_;
+    std::memcpy(bytes + header->statuses_offset, statuses_.data(),
+                statuses_.size());
+    std::memcpy(bytes + header->last_ticks_offset, last_ticks_.data(),
+                last_ticks_.size() * sizeof(std::uint64_t));
+  });
+}
+
+StatusReader::StatusReader(const std::string &name)
+    : segment_(SharedSegment::open(name, false, sizeof(SegmentHeader),
+                                   "status")) {
+  const auto *bytes = segment_.data();
+  const auto *header = reinterpret_cast<const SegmentHeader *>(bytes);
+  auto size = segment_.size();
+  bool valid =
+      segment_.published(segment_magic) && header->version == segment_version &&
+      header->size == size &&
+      header->topology_offset + header->topology_size <= size &&
+      header->statuses_offset + packed_size(header->node_count) <= size &&
+      header->last_ticks_offset + header->node_count * sizeof(std::uint64_t) <=
+          size;
+  if (!valid) {
+    throw std::runtime_error("Not a status segment: " + name);
+  }
+  SegmentParser parser(bytes + header->topology_offset, header->topology_size,
+                       "status segment topology");
+  topology_.resize(header->node_count);
+  for (auto &node : topology_) {
+    node.children.resize(parser.number<std::uint32_t>());
+    for (auto &child : node.children) {
+      child = parser.number<std::uint32_t>();
+    }
+    node.type = parser.text();
+    node.description = parser.text();
+  }
+  packed_.resize(packed_size(topology_.size()));
+}
+
+StatusReader::~StatusReader() = default;
+
+const std::vector<StatusReader::NodeInfo> &StatusReader::topology() const {
+  return topology_;
+}
+
+bool StatusReader::try_read(Snapshot &snapshot) const {
+  const auto *bytes = segment_.data();
+  const auto *header = reinterpret_cast<const SegmentHeader *>(bytes);
+  snapshot.last_ticks.resize(topology_.size());
+  bool consistent = header->lock.try_read([&] {
+    snapshot.tick = header->tick;
+    std::memcpy(packed_.data(), bytes + header->statuses_offset,
+                packed_.size());
+    std::memcpy(snapshot.last_ticks.data(), bytes + header->last_ticks_offset,
+                snapshot.last_ticks.size() * sizeof(std::uint64_t));
+  });
+  if (!consistent) {
+    return false;
+  }
+  snapshot.statuses.assign(topology_.size(), Status::Failure);
+  for (std::size_t id = 0; id < topology_.size(); ++id) {
+    auto state = (packed_[id / 4] >> ((id % 4) * 2)) & 3;
+    snapshot.statuses[id] = Status(static_cast<Status::State>(state));
+  }
+  return true;
+}
+
+void StatusReader::read(Snapshot &snapshot) const {
+  while (!try_read(snapshot)) {
+  }
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,87 @@
+#include <behavior_tree/thread_pool.h>
+
+namespace evo::behavior {
+
+ThreadPool::ThreadPool(std::size_t workers) {
+  workers_.reserve(workers);
+  for (std::size_t i = 0; i < workers; ++i) {
+    workers_.emplace_back([this] { work(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  batch_started_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+std::size_t ThreadPool::size() const { return workers_.size(); }
+
+void ThreadPool::parallel_for(std::size_t count,
+                              const std::function<void(std::size_t)> &task) {
+  if (count == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    count_ = count;
+    next_.store(0, std::memory_order_relaxed);
+    error_ = nullptr;
+    ++generation_;
+  }
+  if (count > 1) {
+    batch_started_.notify_all();
+  }
+  drain();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  // Workers which have not joined the batch yet find no tasks left
+  workers_idle_.wait(lock, [this] { return busy_ == 0; });
+  task_ = nullptr;
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void ThreadPool::drain() {
+  for (auto index = next_.fetch_add(1); index < count_;
+       index = next_.fetch_add(1)) {
+    try {
+      (*task_)(index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+  }
+}
+
+void ThreadPool::work() {
+  std::size_t seen = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    batch_started_.wait(
+        lock, [&] { return stopping_ || (generation_ != seen && task_); });
+    if (stopping_) {
+      return;
+    }
+    seen = generation_;
+    ++busy_;
+    lock.unlock();
+    drain();
+    lock.lock();
+    if (--busy_ == 0) {
+      workers_idle_.notify_all();
+    }
+  }
+}
+
+} // namespace evo::behavior
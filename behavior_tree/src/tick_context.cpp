@@ -0,0 +1,123 @@
+#include "behavior_tree/tick_context.h"
+#include <algorithm>
+
+namespace evo::behavior {
+
+namespace {
+
+/// The context installed for the current thread.
+thread_local TickContext *current_context = nullptr;
+
+} // namespace
+
+ScratchArena::ScratchArena(std::size_t block_size)
+    : block_size_(std::max<std::size_t>(block_size, 64)) {}
+
+ScratchArena::ScratchArena(const ScratchArena &other)
+    : std::pmr::memory_resource(), block_size_(other.block_size_) {}
+
+ScratchArena &ScratchArena::operator=(const ScratchArena &other) {
+  if (this != &other) {
+    block_size_ = other.block_size_;
+    blocks_.clear();
+    reset();
+  }
+  return *this;
+}
+
+void ScratchArena::reset() {
+  current_ = 0;
+  offset_ = 0;
+  used_before_ = 0;
+}
+
+void ScratchArena::reserve(std::size_t bytes) {
+  auto reserved = capacity();
+  if (reserved < bytes) {
+    auto size = std::max(block_size_, bytes - reserved);
+    blocks_.push_back({std::make_unique<std::byte[]>(size), size});
+  }
+}
+
+std::size_t ScratchArena::used() const { return used_before_ + offset_; }
+
+std::size_t ScratchArena::capacity() const {
+  std::size_t capacity = 0;
+  for (const auto &block : blocks_) {
+    capacity += block.size;
+  }
+  return capacity;
+}
+
+void *ScratchArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  while (current_ < blocks_.size()) {
+    auto &block = blocks_[current_];
+    auto address = reinterpret_cast<std::uintptr_t>(block.data.get());
+    auto start = (address + offset_ + alignment - 1) & ~(alignment - 1);
+    auto end = start - address + bytes;
+    if (end <= block.size) {
+      offset_ = end;
+      return reinterpret_cast<void *>(start);
+    }
+    // Move on to the next block, which may be left over from an earlier tick
+    used_before_ += offset_;
+    offset_ = 0;
+    if (current_ + 1 == blocks_.size()) {
+      break;
+    }
+    ++current_;
+  }
+  auto size = std::max(block_size_, bytes + alignment);
+  blocks_.push_back({std::make_unique<std::byte[]>(size), size});
+  current_ = blocks_.size() - 1;
+  offset_ = 0;
+  return do_allocate(bytes, alignment);
+}
+
+TickContext::Scope::Scope(TickContext *context) : previous_(current_context) {
+  current_context = context;
+}
+
+TickContext::Scope::~Scope() { current_context = previous_; }
+
+TickContext::TickContext(const Clock *clock, std::any *user_data)
+    : clock_(clock), user_data_(user_data) {}
+
+TickContext *TickContext::current() { return current_context; }
+
+TickContext TickContext::branch() const {
+  TickContext branched(clock_, user_data_);
+  branched.now_ = now_;
+  branched.tick_ = tick_;
+  return branched;
+}
+
+void TickContext::begin() {
+  begin(clock_ ? clock_->now() : Clock::TimePoint());
+}
+
+void TickContext::begin(Clock::TimePoint now) {
+  now_ = now;
+  ++tick_;
+}
+
+void TickContext::end() { scratch_.reset(); }
+
+Clock::TimePoint TickContext::now() const { return now_; }
+
+const Clock *TickContext::clock() const { return clock_; }
+
+std::uint64_t TickContext::tick() const { return tick_; }
+
+ScratchArena &TickContext::scratch() { return scratch_; }
+
+void TickContext::set_user_data(std::any *user_data) { user_data_ = user_data; }
+
+void TickContext::set_clock(const Clock *clock) { clock_ = clock; }
+
+Clock::TimePoint tick_time(const Clock &clock) {
+  auto *context = current_context;
+  return context && context->clock() == &clock ? context->now() : clock.now();
+}
+
+} // namespace evo::behavior
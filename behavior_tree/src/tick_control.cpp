@@ -0,0 +1,47 @@
+#include "behavior_tree/tick_control.h"
+#include "behavior_tree/interrupts.h"
+#include "behavior_tree/load_shedder.h"
+
+namespace evo::behavior {
+
+namespace {
+
+/// The control installed for the current thread.
+thread_local TickControl *current_control = nullptr;
+
+} // namespace
+
+TickControl::Scope::Scope(TickControl *control) : previous_(current_control) {
+  current_control = control;
+}
+
+TickControl::Scope::~Scope() { current_control = previous_; }
+
+TickControl *TickControl::current() { return current_control; }
+
+void TickControl::set_deadline(ClockPtr clock, Clock::TimePoint deadline) {
+  clock_ = std::move(clock);
+  deadline_ = deadline;
+}
+
+void TickControl::set_load_shedder(LoadShedder *shedder) { shedder_ = shedder; }
+
+void TickControl::set_observers(const std::vector<TickObserver *> *observers) {
+  observers_ = observers && !observers->empty() ? observers : nullptr;
+}
+
+void TickControl::set_interrupts(InterruptService *interrupts) {
+  interrupts_ = interrupts;
+}
+
+void TickControl::service_interrupts() {
+  if (interrupts_->pending()) {
+    interrupts_->service();
+  }
+}
+
+std::optional<Status> TickControl::shed_with_shedder(const BehaviorNode &node) {
+  return shedder_->shed(node);
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,137 @@
+#include "behavior_tree/trace_recorder.h"
+#include "behavior_tree/nodes/behavior_node.h"
+#include <fstream>
+#include <iomanip>
+
+namespace evo::behavior {
+
+namespace {
+
+/// Writes a string as a JSON string literal.
+void write_json_string(std::ostream &out, const std::string &text) {
+  out << '"';
+  for (char c : text) {
+    switch (c) {
+    case '"':
+      out << "\\\"";
+      break;
+    case '\\':
+      out << "\\\\";
+      break;
+    case '\n':
+      out << "\\n";
+      break;
+    case '\t':
+      out << "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+            << static_cast<int>(c) << std::dec << std::setfill(' ');
+      } else {
+        out << c;
+      }
+    }
+  }
+  out << '"';
+}
+
+} // namespace
+
+TraceRecorder::TraceRecorder(std::size_t max_ticks, ClockPtr clock)
+    : max_ticks_(max_ticks), clock_(std::move(clock)) {}
+
+std::size_t TraceRecorder::ticks() const { return ticks_.size(); }
+
+void TraceRecorder::clear() {
+  ticks_.clear();
+  labels_.clear();
+  label_index_.clear();
+  depth_ = 0;
+}
+
+void TraceRecorder::start_tick() {
+  if (max_ticks_ != 0 && ticks_.size() >= max_ticks_) {
+    // Reuse the oldest tick's buffer
+    auto oldest = std::move(ticks_.front());
+    ticks_.pop_front();
+    oldest.clear();
+    ticks_.push_back(std::move(oldest));
+  } else {
+    ticks_.emplace_back();
+  }
+}
+
+std::uint32_t TraceRecorder::intern(const BehaviorNode &node) {
+  const auto &name = node.description().empty() ? node.type()
+                                                : node.description();
+  auto [it, inserted] = label_index_.try_emplace(&node, 0);
+  if (!inserted) {
+    // A freed node's address may be reused by another node
+    const auto &label = labels_[it->second];
+    if (label.name == name && label.type == node.type()) {
+      return it->second;
+    }
+  }
+  it->second = static_cast<std::uint32_t>(labels_.size());
+  labels_.push_back({name, node.type()});
+  return it->second;
+}
+
+void TraceRecorder::on_enter(const BehaviorNode &node) {
+  if (depth_++ == 0) {
+    start_tick();
+  }
+  ticks_.back().push_back({intern(node), clock_->now(), true, Status::FAILURE});
+}
+
+void TraceRecorder::on_exit(const BehaviorNode &node, Status status) {
+  if (depth_ == 0) {
+    return; // Entered before the recorder was cleared
+  }
+  --depth_;
+  ticks_.back().push_back({intern(node), clock_->now(), false, status});
+}
+
+void TraceRecorder::write_chrome_trace(std::ostream &out) const {
+  auto flags = out.flags();
+  auto precision = out.precision();
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto &tick : ticks_) {
+    for (const auto &event : tick) {
+      const auto &label = labels_[event.label];
+      auto microseconds =
+          std::chrono::duration<double, std::micro>(event.time.time_since_epoch())
+              .count();
+      out << (first ? "\n" : ",\n") << "{\"name\":";
+      write_json_string(out, label.name);
+      out << ",\"cat\":";
+      write_json_string(out, label.type);
+      out << ",\"ph\":\"" << (event.begin ? 'B' : 'E') << "\",\"ts\":"
+          << microseconds << ",\"pid\":1,\"tid\":1";
+      if (!event.begin) {
+        out << ",\"args\":{\"type\":";
+        write_json_string(out, label.type);
+        out << ",\"status\":\"" << Status(event.status) << "\"}";
+      }
+      out << "}";
+      first = false;
+    }
+  }
+  out << "\n]}\n";
+  out.flags(flags);
+  out.precision(precision);
+}
+
+bool TraceRecorder::write_chrome_trace(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file) {
+    return false;
+  }
+  write_chrome_trace(file);
+  return static_cast<bool>(file);
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,136 @@
+#include "behavior_tree/transition_stream.h"
+#include <algorithm>
+
+namespace evo::behavior {
+
+namespace {
+
+/// The previous status of a node which has not been ticked yet.
+constexpr std::uint8_t never_ticked = 0xff;
+
+} // namespace
+
+TransitionSubscription::TransitionSubscription(BehaviorPtr subtree,
+                                               std::size_t capacity)
+    : subtree_(std::move(subtree)), queue_(capacity) {}
+
+bool TransitionSubscription::pop(TransitionEvent &event) {
+  return queue_.pop(event);
+}
+
+std::uint64_t TransitionSubscription::dropped() const {
+  return dropped_.load(std::memory_order_relaxed);
+}
+
+std::optional<TransitionNode>
+TransitionSubscription::node(const TransitionEvent &event) const {
+  auto labels = std::atomic_load(&labels_);
+  if (!labels || labels->generation != event.generation ||
+      event.node >= labels->nodes.size()) {
+    return std::nullopt;
+  }
+  return labels->nodes[event.node];
+}
+
+TransitionTracker::TransitionTracker(ClockPtr clock)
+    : clock_(std::move(clock)), index_(std::make_shared<NodeIndex>(nullptr)),
+      labels_(std::make_shared<TransitionSubscription::Labels>()) {}
+
+void TransitionTracker::set_root(const BehaviorPtr &root) {
+  set_index(std::make_shared<NodeIndex>(root));
+}
+
+void TransitionTracker::set_index(std::shared_ptr<const NodeIndex> index) {
+  index_ = std::move(index);
+  auto labels = std::make_shared<TransitionSubscription::Labels>();
+  labels->generation = index_->generation();
+  for (std::uint32_t id = 0; id < index_->size(); ++id) {
+    auto node = index_->node(id);
+    labels->nodes.push_back(
+        node ? TransitionNode{node->type(), node->description()}
+             : TransitionNode{});
+  }
+  labels_ = std::move(labels);
+  previous_.assign(index_->size(), never_ticked);
+  for (auto &subscription : subscriptions_) {
+    update_members(*subscription);
+  }
+}
+
+void TransitionTracker::set_clock(ClockPtr clock) { clock_ = std::move(clock); }
+
+void TransitionTracker::add(
+    const std::shared_ptr<TransitionSubscription> &subscription) {
+  update_members(*subscription);
+  subscriptions_.push_back(subscription);
+}
+
+void TransitionTracker::remove(
+    const std::shared_ptr<TransitionSubscription> &subscription) {
+  subscriptions_.erase(std::remove(subscriptions_.begin(),
+                                   subscriptions_.end(), subscription),
+                       subscriptions_.end());
+}
+
+bool TransitionTracker::empty() const { return subscriptions_.empty(); }
+
+void TransitionTracker::update_members(
+    TransitionSubscription &subscription) const {
+  std::atomic_store(&subscription.labels_, labels_);
+  subscription.members_.assign(index_->size(), !subscription.subtree_);
+  if (!subscription.subtree_) {
+    return; // The whole tree, whatever its root
+  }
+  std::vector<const BehaviorNode *> pending{subscription.subtree_.get()};
+  while (!pending.empty()) {
+    const auto *node = pending.back();
+    pending.pop_back();
+    auto id = index_->find(*node);
+    if (!id || subscription.members_[*id]) {
+      continue; // Not part of the tree, or already visited
+    }
+    subscription.members_[*id] = true;
+    for (const auto &child : node->children()) {
+      pending.push_back(child.get());
+    }
+  }
+}
+
+void TransitionTracker::on_enter(const BehaviorNode &) {
+  if (depth_++ == 0) {
+    ++tick_;
+  }
+}
+
+void TransitionTracker::on_exit(const BehaviorNode &node, Status status) {
+  if (depth_ > 0) {
+    --depth_;
+  }
+  auto id = index_->find(node);
+  if (!id) {
+    return;
+  }
+  auto state = static_cast<std::uint8_t>(Status::State(status));
+  auto &previous = previous_[*id];
+  if (previous == state) {
+    return;
+  }
+  TransitionEvent event;
+  event.node = *id;
+  event.generation = index_->generation();
+  event.initial = previous == never_ticked;
+  event.from = event.initial ? Status::State(status)
+                             : static_cast<Status::State>(previous);
+  event.to = Status::State(status);
+  event.tick = tick_;
+  event.time = clock_->now();
+  previous = state;
+  for (auto &subscription : subscriptions_) {
+    if (subscription->members_[event.node] &&
+        !subscription->queue_.push(event)) {
+      subscription->dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,221 @@
+#include "behavior_tree/tree_executor.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace evo::behavior {
+
+TreeExecutor::TreeExecutor(std::size_t workers, ClockPtr clock)
+    : clock_(std::move(clock)) {
+  workers = std::max<std::size_t>(workers, 1);
+  for (std::size_t i = 0; i < workers; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  workers_.reserve(workers);
+  for (std::size_t i = 0; i < workers; ++i) {
+    workers_.emplace_back([this, i] { work(i); });
+  }
+}
+
+TreeExecutor::~TreeExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+TreeExecutor::TreeId TreeExecutor::add(std::shared_ptr<BehaviorTree> tree,
+                                       Clock::Duration period,
+                                       Clock::Duration deadline) {
+  if (!tree) {
+    throw std::invalid_argument("TreeExecutor requires a tree");
+  }
+  if (period <= Clock::Duration::zero() || deadline < Clock::Duration::zero()) {
+    throw std::invalid_argument("TreeExecutor requires a positive period");
+  }
+  auto entry = std::make_shared<Entry>();
+  entry->tree = std::move(tree);
+  entry->period = period;
+  entry->deadline = deadline == Clock::Duration::zero() ? period : deadline;
+
+  auto now = clock_->now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto id = next_id_++;
+  entries_.emplace(id, entry);
+  timers_.push_back({now, now + entry->deadline, std::move(entry)});
+  std::push_heap(timers_.begin(), timers_.end(), later_release);
+  wake_.notify_one();
+  return id;
+}
+
+void TreeExecutor::remove(TreeId id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto entry = entries_.find(id);
+  if (entry == entries_.end()) {
+    return;
+  }
+  entry->second->removed = true;
+  timers_.erase(std::remove_if(timers_.begin(), timers_.end(),
+                               [&](const Job &job) {
+                                 return job.entry == entry->second;
+                               }),
+                timers_.end());
+  std::make_heap(timers_.begin(), timers_.end(), later_release);
+  entries_.erase(entry);
+}
+
+TreeStats TreeExecutor::stats(TreeId id) const {
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = entries_.find(id);
+    if (found == entries_.end()) {
+      throw std::out_of_range("Unknown tree " + std::to_string(id));
+    }
+    entry = found->second;
+  }
+  std::lock_guard<std::mutex> lock(entry->stats_mutex);
+  return entry->stats;
+}
+
+std::size_t TreeExecutor::size() const { return workers_.size(); }
+
+bool TreeExecutor::later_release(const Job &a, const Job &b) {
+  return a.release > b.release;
+}
+
+bool TreeExecutor::later_deadline(const Job &a, const Job &b) {
+  return a.deadline > b.deadline;
+}
+
+void TreeExecutor::work(std::size_t worker) {
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopping_) {
+        return;
+      }
+      release(worker, clock_->now());
+    }
+    Job job;
+    if (take(worker, job)) {
+      run(job);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopping_) {
+      return;
+    }
+    if (ready_.load() > 0) {
+      continue; // Released to another worker, which is busy; steal it
+    }
+    if (timers_.empty()) {
+      wake_.wait(lock);
+    } else {
+      wake_.wait_for(lock, timers_.front().release - clock_->now());
+    }
+  }
+}
+
+void TreeExecutor::release(std::size_t worker, Clock::TimePoint now) {
+  std::size_t released = 0;
+  auto &queue = *queues_[worker];
+  while (!timers_.empty() && timers_.front().release <= now) {
+    std::pop_heap(timers_.begin(), timers_.end(), later_release);
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.jobs.push_back(std::move(timers_.back()));
+      std::push_heap(queue.jobs.begin(), queue.jobs.end(), later_deadline);
+    }
+    timers_.pop_back();
+    ready_.fetch_add(1);
+    // This worker runs one of them; wake others to steal the rest
+    if (released++ > 0) {
+      wake_.notify_one();
+    }
+  }
+}
+
+bool TreeExecutor::take(std::size_t worker, Job &job) {
+  auto pop = [&](Queue &queue) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) {
+      return false;
+    }
+    std::pop_heap(queue.jobs.begin(), queue.jobs.end(), later_deadline);
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    ready_.fetch_sub(1);
+    return true;
+  };
+  if (pop(*queues_[worker])) {
+    return true;
+  }
+
+  // Steal the job with the earliest deadline among the other workers
+  Queue *victim = nullptr;
+  Clock::TimePoint earliest = Clock::TimePoint::max();
+  for (std::size_t i = 1; i < queues_.size(); ++i) {
+    auto &queue = *queues_[(worker + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty() && queue.jobs.front().deadline < earliest) {
+      earliest = queue.jobs.front().deadline;
+      victim = &queue;
+    }
+  }
+  return victim && pop(*victim);
+}
+
+void TreeExecutor::run(const Job &job) {
+  auto &entry = *job.entry;
+  if (entry.removed) {
+    return;
+  }
+  auto start = clock_->now();
+  Status status = Status::Failure;
+  bool threw = false;
+  try {
+    status = entry.tree->run();
+  } catch (...) {
+    threw = true;
+  }
+  auto end = clock_->now();
+
+  // Skip the releases which are over by now, but tick once if behind
+  auto next = job.release + entry.period;
+  std::uint64_t skipped = 0;
+  if (end >= next + entry.period) {
+    auto behind = (end - next) / entry.period;
+    next += behind * entry.period;
+    skipped = static_cast<std::uint64_t>(behind);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(entry.stats_mutex);
+    auto &stats = entry.stats;
+    auto start_delay = start - job.release;
+    auto lateness = end - job.deadline;
+    ++stats.ticks;
+    stats.deadline_misses += lateness > Clock::Duration::zero();
+    stats.skipped_releases += skipped;
+    stats.exceptions += threw;
+    stats.max_start_delay = std::max(stats.max_start_delay, start_delay);
+    stats.total_start_delay += start_delay;
+    stats.max_lateness = std::max(stats.max_lateness, lateness);
+    stats.total_lateness += lateness;
+    stats.last_status = status;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entry.removed || stopping_) {
+    return;
+  }
+  timers_.push_back({next, next + entry.deadline, job.entry});
+  std::push_heap(timers_.begin(), timers_.end(), later_release);
+  wake_.notify_one();
+}
+
+} // namespace evo::behavior
@@ -0,0 +1,167 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+namespace {
+
+// Builds a random pure subtree over the given conditions.
+BehaviorPtr random_formula(const std::vector<BehaviorPtr> &conditions,
+                           std::mt19937 &random, int depth) {
+  std::uniform_int_distribution<int> kind(0, depth > 0 ? 3 : 0);
+  std::uniform_int_distribution<size_t> pick(0, conditions.size() - 1);
+  switch (kind(random)) {
+  case 1:
+    return not_(random_formula(conditions, random, depth - 1));
+  case 2:
+    return sequence(random_formula(conditions, random, depth - 1),
+                    random_formula(conditions, random, depth - 1),
+                    random_formula(conditions, random, depth - 1));
+  case 3:
+    return fallback(random_formula(conditions, random, depth - 1),
+                    random_formula(conditions, random, depth - 1));
+  default:
+    return conditions[pick(random)];
+  }
+}
+
+// Checks that formulas over a number of conditions match their subtrees,
+// optionally with some conditions running.
+void check_random_formulas(size_t count, int depth, bool table,
+                           bool running = false) {
+  std::vector<Status> inputs(count, Status::Failure);
+  std::vector<BehaviorPtr> conditions;
+  for (size_t i = 0; i < count; ++i) {
+    conditions.push_back(condition([&inputs, i] { return inputs[i]; }));
+  }
+  std::mt19937 random(7);
+  std::bernoulli_distribution coin;
+  std::bernoulli_distribution rarely(0.1);
+  for (int tree = 0; tree < 20; ++tree) {
+    auto subtree = random_formula(conditions, random, depth);
+    auto formula = std::make_shared<BooleanFormula>(subtree);
+    if (formula->children().size() > BooleanFormula::max_table_conditions) {
+      ASSERT_FALSE(formula->uses_table());
+    } else if (table) {
+      ASSERT_TRUE(formula->uses_table());
+    }
+    for (int tick = 0; tick < 200; ++tick) {
+      for (auto &input : inputs) {
+        input = running && rarely(random) ? Status::Running
+                                          : Status(coin(random));
+      }
+      ASSERT_EQ((*formula)(), (*subtree)()) << "tree " << tree;
+    }
+  }
+}
+
+} // namespace
+
+// Small formulas are looked up in a truth table
+TEST(BehaviorTreeTest, BooleanFormulaTableMatchesSubtree) {
+  check_random_formulas(6, 4, true);
+}
+
+// Large formulas are evaluated with a decision diagram
+TEST(BehaviorTreeTest, BooleanFormulaDiagramMatchesSubtree) {
+  check_random_formulas(40, 6, false);
+}
+
+// Conditions shared within the subtree are sampled once
+TEST(BehaviorTreeTest, BooleanFormulaSamplesConditionsOnce) {
+  size_t samples = 0;
+  auto shared = condition([&samples] {
+    ++samples;
+    return Status::Success;
+  });
+  auto other = condition([] { return Status::Failure; });
+  auto formula = boolean_formula(
+      fallback(sequence(shared, other), sequence(not_(other), shared)));
+
+  ASSERT_EQ(formula->children().size(), 2);
+  ASSERT_EQ((*formula)(), Status::Success);
+  ASSERT_EQ(samples, 1);
+}
+
+// A running condition only makes the formula running where the subtree is
+TEST(BehaviorTreeTest, BooleanFormulaRunning) {
+  auto running = condition([] { return Status::Running; });
+  auto failing = condition([] { return Status::Failure; });
+  auto succeeding = condition([] { return Status::Success; });
+  ASSERT_EQ((*boolean_formula(sequence(running, succeeding)))(),
+            Status::Running);
+  ASSERT_EQ((*boolean_formula(sequence(running, failing)))(), Status::Running);
+  ASSERT_EQ((*boolean_formula(sequence(failing, running)))(), Status::Failure);
+  ASSERT_EQ((*boolean_formula(fallback(succeeding, running)))(),
+            Status::Success);
+  ASSERT_EQ((*boolean_formula(fallback(failing, not_(running))))(),
+            Status::Running);
+  ASSERT_EQ((*boolean_formula(not_(fallback(failing, not_(failing)))))(),
+            Status::Failure);
+}
+
+// Formulas with running conditions match their subtrees
+TEST(BehaviorTreeTest, BooleanFormulaRunningMatchesSubtree) {
+  check_random_formulas(6, 4, true, true);
+  check_random_formulas(40, 6, false, true);
+}
+
+// Subtrees with other node types cannot be compiled
+TEST(BehaviorTreeTest, BooleanFormulaRejectsImpureSubtree) {
+  ASSERT_FALSE(BooleanFormula::is_pure(*sequence(action([] {}))));
+  ASSERT_THROW(boolean_formula(sequence(action([] {}))),
+               std::invalid_argument);
+  ASSERT_THROW(boolean_formula(nullptr), std::invalid_argument);
+}
+
+// Only maximal pure subtrees with enough conditions are compiled
+TEST(BehaviorTreeTest, CompileConditionsReplacesPureSubtrees) {
+  bool first = true;
+  bool second = false;
+  size_t acted = 0;
+  auto gate = sequence(not_(condition([&first] { return Status(first); })),
+                       fallback(condition([&first] { return Status(first); }),
+                                condition([&second] { return Status(second); })));
+  auto single = not_(condition([&second] { return Status(second); }));
+  auto act = action([&acted] { ++acted; });
+  auto root = fallback(gate, if_then("", single, act));
+
+  ASSERT_EQ(compile_conditions(root), root);
+  ASSERT_EQ(root->children()[0]->type(), "boolean_formula");
+  ASSERT_EQ(root->children()[0]->children().size(), 3);
+  ASSERT_EQ(root->children()[1]->children()[0], single);
+
+  ASSERT_EQ((*root)(), Status::Success);
+  ASSERT_EQ(acted, 1);
+  second = true;
+  ASSERT_EQ((*root)(), Status::Success);
+  ASSERT_EQ(acted, 1);
+  first = false;
+  ASSERT_EQ((*root)(), Status::Success);
+  ASSERT_EQ(acted, 1);
+  second = false;
+  ASSERT_EQ((*root)(), Status::Success);
+  ASSERT_EQ(acted, 2);
+}
+
+// A pure tree compiles into a new root
+TEST(BehaviorTreeTest, CompileConditionsPureRoot) {
+  auto root = fallback(condition([] { return Status::Failure; }),
+                       condition([] { return Status::Success; }));
+  auto compiled = compile_conditions(root);
+  ASSERT_NE(compiled, root);
+  ASSERT_EQ((*compiled)(), Status::Success);
+}
+
+// Children are replaced in place and the node ticks the new child
+TEST(BehaviorTreeTest, ReplaceChild) {
+  auto node = try_else("", condition([] { return Status::Failure; }),
+                       condition([] { return Status::Failure; }));
+  node->replace_child(1, condition([] { return Status::Success; }));
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_THROW(node->replace_child(2, node), std::out_of_range);
+  ASSERT_THROW(node->replace_child(0, nullptr), std::invalid_argument);
+}
@@ -0,0 +1,69 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+// A budgeted run stops when the budget is spent and resumes where it stopped
+TEST(BehaviorTreeTest, BudgetedRunResumes) {
+  auto clock = std::make_shared<SimulatedClock>();
+  std::vector<size_t> visits(3, 0);
+  auto step = [&](size_t index) {
+    return action([&, index] {
+      ++visits[index];
+      clock->advance(10ms);
+    });
+  };
+  BehaviorTree bt(sequence(step(0), fallback(condition([] {
+                                               return Status::Failure;
+                                             }),
+                                             step(1)),
+                           step(2)));
+  bt.set_clock(clock);
+
+  ASSERT_EQ(bt.run(15ms), Status::Incomplete);
+  ASSERT_EQ(visits, (std::vector<size_t>{1, 1, 0}));
+
+  ASSERT_EQ(bt.run(15ms), Status::Success);
+  ASSERT_EQ(visits, (std::vector<size_t>{1, 1, 1}));
+
+  // A complete tick starts from the beginning again
+  ASSERT_EQ(bt.run(1s), Status::Success);
+  ASSERT_EQ(visits, (std::vector<size_t>{2, 2, 2}));
+}
+
+// Every budgeted run ticks at least one leaf
+TEST(BehaviorTreeTest, BudgetedRunAlwaysAdvances) {
+  auto clock = std::make_shared<SimulatedClock>();
+  size_t visits = 0;
+  auto leaf = action([&] { ++visits; });
+  BehaviorTree bt(sequence(sequence(leaf, leaf), sequence(leaf)));
+  bt.set_clock(clock);
+
+  ASSERT_EQ(bt.run(0ms), Status::Incomplete);
+  ASSERT_EQ(bt.run(0ms), Status::Incomplete);
+  ASSERT_EQ(bt.run(0ms), Status::Success);
+  ASSERT_EQ(visits, 3);
+}
+
+// An unbudgeted run finishes an incomplete traversal
+TEST(BehaviorTreeTest, UnbudgetedRunFinishesTraversal) {
+  auto clock = std::make_shared<SimulatedClock>();
+  size_t condition_visits = 0;
+  size_t action_visits = 0;
+  BehaviorTree bt(if_then_else("", condition([&] {
+                                 ++condition_visits;
+                                 return Status::Failure;
+                               }),
+                               action([] {}),
+                               sequence(action([&] { ++action_visits; }),
+                                        action([&] { ++action_visits; }))));
+  bt.set_clock(clock);
+
+  ASSERT_EQ(bt.run(0ms), Status::Incomplete);
+  ASSERT_EQ(bt.run(), Status::Success);
+  ASSERT_EQ(condition_visits, 1); // The condition is not checked again
+  ASSERT_EQ(action_visits, 2);
+}
@@ -0,0 +1,132 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+// Changes are applied in submission order when the node is ticked next
+TEST(BehaviorTreeTest, DynamicCompositeChanges) {
+  std::vector<std::string> trace;
+  auto step = [&](const std::string &name, Status status) {
+    return condition(
+        [&trace, name, status] {
+          trace.push_back(name);
+          return status;
+        },
+        name);
+  };
+  auto a = step("a", Status::Failure);
+  auto b = step("b", Status::Failure);
+  auto node = dynamic_fallback("jobs", a);
+  BehaviorTree tree(node);
+
+  node->append(b);
+  node->append(step("c", Status::Success));
+  ASSERT_EQ(node->children().size(), 1);
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(trace, (std::vector<std::string>{"a", "b", "c"}));
+
+  trace.clear();
+  node->remove(a);
+  node->replace(b, step("d", Status::Running));
+  node->remove(a); // No longer a child
+  ASSERT_EQ(tree.run(), Status::Running);
+  ASSERT_EQ(trace, (std::vector<std::string>{"d"}));
+  ASSERT_EQ(node->children().size(), 2);
+
+  node->clear();
+  node->append(step("e", Status::Failure));
+  ASSERT_EQ(tree.run(), Status::Failure);
+  ASSERT_EQ(node->children().size(), 1);
+  ASSERT_THROW(node->append(nullptr), std::invalid_argument);
+}
+
+// Consumed children work like a queue of jobs
+TEST(BehaviorTreeTest, DynamicSequenceConsumesJobs) {
+  std::vector<int> done;
+  bool blocked = true;
+  auto job = [&](int id) {
+    return condition([&, id] {
+      if (id == 2 && blocked) {
+        return Status::Running;
+      }
+      done.push_back(id);
+      return Status::Success;
+    });
+  };
+  auto queue = dynamic_sequence();
+  queue->consume_finished();
+  ASSERT_TRUE(queue->consumes_finished());
+  BehaviorTree tree(queue);
+
+  ASSERT_EQ(tree.run(), Status::Success);
+  for (int id = 1; id <= 3; ++id) {
+    queue->append(job(id));
+  }
+  ASSERT_EQ(tree.run(), Status::Running);
+  ASSERT_EQ(done, (std::vector<int>{1}));
+  ASSERT_EQ(queue->children().size(), 2);
+
+  blocked = false;
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(done, (std::vector<int>{1, 2, 3}));
+  ASSERT_TRUE(queue->children().empty());
+}
+
+// Jobs submitted from several threads are all run exactly once
+TEST(BehaviorTreeTest, DynamicSequenceConcurrentSubmissions) {
+  constexpr int producers = 4;
+  constexpr int jobs = 1000;
+  std::atomic<int> submitted{0};
+  int executed = 0;
+  auto queue = dynamic_sequence("dispatch");
+  queue->consume_finished();
+  BehaviorTree tree(queue);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < jobs; ++i) {
+        queue->append(action([&executed] { ++executed; }));
+        ++submitted;
+      }
+    });
+  }
+  while (submitted < producers * jobs) {
+    ASSERT_EQ(tree.run(), Status::Success);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(executed, producers * jobs);
+  ASSERT_TRUE(queue->children().empty());
+}
+
+// Changes wait until an incomplete traversal has finished
+TEST(BehaviorTreeTest, DynamicCompositeDefersChangesDuringTraversal) {
+  auto clock = std::make_shared<SimulatedClock>();
+  std::vector<int> visits(3, 0);
+  auto step = [&](int index) {
+    return action([&, index] {
+      ++visits[index];
+      clock->advance(10ms);
+    });
+  };
+  auto first = step(0);
+  auto node = dynamic_sequence(first, step(1));
+  BehaviorTree tree(node);
+  tree.set_clock(clock);
+
+  ASSERT_EQ(tree.run(5ms), Status::Incomplete);
+  node->remove(first);
+  node->append(step(2));
+  ASSERT_EQ(tree.run(1s), Status::Success);
+  ASSERT_EQ(visits, (std::vector<int>{1, 1, 0}));
+  ASSERT_EQ(tree.run(1s), Status::Success);
+  ASSERT_EQ(visits, (std::vector<int>{1, 2, 1}));
+}
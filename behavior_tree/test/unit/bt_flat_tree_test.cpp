@@ -0,0 +1,164 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+// A user-defined node, which the flat tree ticks through operator().
+class CountingNode : public BehaviorNode {
+public:
+  CountingNode(size_t &visits, BehaviorPtr child)
+      : BehaviorNode("counting", "", child), visits_(visits) {}
+
+  Status operator()() override {
+    ++visits_;
+    return tick_child(children().front());
+  }
+
+private:
+  size_t &visits_;
+};
+
+// Inputs and side effects of a test tree.
+struct World {
+  std::vector<Status> inputs = std::vector<Status>(6, Status::Failure);
+  std::vector<size_t> visits = std::vector<size_t>(7, 0);
+};
+
+// Builds a tree which uses all built-in node types.
+BehaviorPtr make_tree(World &world) {
+  auto input = [&world](size_t index) {
+    return condition([&world, index] {
+      ++world.visits[index];
+      return world.inputs[index];
+    });
+  };
+  auto [latch, unlatch] = latch_and_unlatch(input(5));
+  // clang-format off
+  return
+  parallel(
+    sequence_memory(
+      input(0),
+      fallback(not_(input(1)), input(2)),
+      latch,
+      if_then("", input(3), action([&world] { ++world.visits[6]; }))
+    ),
+    fallback_memory(
+      skipper(input(4), input(0)),
+      try_else("", input(1), unlatch),
+      if_then_else("", input(2), input(3), input(4))
+    ),
+    std::make_shared<CountingNode>(world.visits[6], input(2))
+  );
+  // clang-format on
+}
+
+// The flat tree behaves exactly like the interpreted one
+TEST(BehaviorTreeTest, FlatTreeMatchesInterpretedTree) {
+  World interpreted_world;
+  World flat_world;
+  BehaviorTree interpreted(make_tree(interpreted_world));
+  FlatTree flat(make_tree(flat_world));
+
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> state(0, 2);
+  for (int tick = 0; tick < 2000; ++tick) {
+    for (size_t i = 0; i < interpreted_world.inputs.size(); ++i) {
+      Status input = Status::State(state(random));
+      interpreted_world.inputs[i] = input;
+      flat_world.inputs[i] = input;
+    }
+    ASSERT_EQ(interpreted.run(), flat.run()) << "tick " << tick;
+    ASSERT_EQ(interpreted_world.visits, flat_world.visits) << "tick " << tick;
+  }
+}
+
+// The flat tree keeps a single state for nodes shared between parents
+TEST(BehaviorTreeTest, FlatTreeSharedNodes) {
+  auto shared = sequence_memory(action([] {}), condition([] {
+                                  return Status::Running;
+                                }));
+  FlatTree flat(sequence(shared, shared));
+  ASSERT_EQ(flat.size(), 4);
+  ASSERT_EQ(flat.run(), Status::Running);
+}
+
+// A fork advances its own memory state only
+TEST(BehaviorTreeTest, FlatTreeFork) {
+  Status second = Status::Running;
+  size_t first_visits = 0;
+  FlatTree tree(sequence_memory(condition([&first_visits] {
+                                  ++first_visits;
+                                  return Status::Success;
+                                }),
+                                condition([&second] { return second; })));
+  ASSERT_EQ(tree.run(), Status::Running);
+  ASSERT_EQ(first_visits, 1);
+
+  auto fork = tree.fork();
+  second = Status::Success;
+  ASSERT_EQ(fork.run(), Status::Success);
+  ASSERT_EQ(fork.run(), Status::Success);
+  ASSERT_EQ(first_visits, 2);
+
+  // The live tree still resumes from its second child
+  second = Status::Running;
+  ASSERT_EQ(tree.run(), Status::Running);
+  ASSERT_EQ(first_visits, 2);
+}
+
+// A dry run resolves conditions from the overlay and records actions
+TEST(BehaviorTreeTest, FlatTreeDryRun) {
+  size_t executed = 0;
+  auto obstacle = condition([] { return Status::Failure; });
+  auto drive = action([&executed] { ++executed; });
+  auto stop = action([&executed] { ++executed; });
+  auto [latch, unlatch] = latch_and_unlatch(stop);
+  FlatTree tree(fallback(sequence(not_(obstacle), drive),
+                         sequence(latch, unlatch)));
+
+  FlatTree::DryRun clear;
+  auto fork = tree.fork();
+  ASSERT_EQ(fork.dry_run(clear), Status::Success);
+  ASSERT_EQ(clear.actions, std::vector<const BehaviorNode *>{drive.get()});
+
+  FlatTree::DryRun blocked;
+  blocked.overlay.emplace(obstacle.get(), Status::Success);
+  blocked.overlay.emplace(stop.get(), Status::Failure);
+  ASSERT_EQ(fork.dry_run(blocked), Status::Failure);
+  ASSERT_EQ(blocked.actions, std::vector<const BehaviorNode *>{stop.get()});
+  ASSERT_EQ(executed, 0);
+
+  // The latch of the fork holds the hypothetical result
+  blocked.actions.clear();
+  ASSERT_EQ(fork.dry_run(blocked), Status::Failure);
+  ASSERT_TRUE(blocked.actions.empty());
+}
+
+// Forks explore hypothetical inputs on several threads
+TEST(BehaviorTreeTest, FlatTreeParallelForks) {
+  std::vector<BehaviorPtr> inputs;
+  for (int i = 0; i < 4; ++i) {
+    inputs.push_back(condition([] { return Status::Failure; }));
+  }
+  auto act = action([] {});
+  FlatTree tree(sequence_memory(inputs[0], fallback(inputs[1], inputs[2]),
+                                not_(inputs[3]), act));
+
+  // Each hypothesis assigns the inputs the bits of its number
+  std::vector<Status> results(16, Status::Running);
+  ThreadPool pool(3);
+  pool.parallel_for(results.size(), [&](size_t hypothesis) {
+    FlatTree::DryRun dry_run;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      dry_run.overlay.emplace(inputs[i].get(), Status((hypothesis >> i) & 1));
+    }
+    results[hypothesis] = tree.fork().dry_run(dry_run);
+  });
+  for (size_t hypothesis = 0; hypothesis < results.size(); ++hypothesis) {
+    bool expected = (hypothesis & 1) && (hypothesis & 6) && !(hypothesis & 8);
+    ASSERT_EQ(results[hypothesis], Status(expected)) << hypothesis;
+  }
+}
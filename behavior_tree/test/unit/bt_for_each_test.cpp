@@ -0,0 +1,122 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <atomic>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+// Items are combined under all, any and at least semantics
+TEST(BehaviorTreeTest, ForEachPolicies) {
+  std::vector<double> distances{12, 3, 8, 20};
+  std::vector<int> checks(distances.size(), 0);
+  auto clear = [&](std::size_t i) {
+    return condition(
+        [&, i] {
+          ++checks[i];
+          return Status(distances[i] > 5);
+        },
+        "clear " + std::to_string(i));
+  };
+  auto size = [&] { return distances.size(); };
+
+  BehaviorTree all(for_each("all clear", size, clear));
+  ASSERT_EQ(all.run(), Status::Failure);
+  // The result is decided by the second item
+  ASSERT_EQ(checks, (std::vector<int>{1, 1, 0, 0}));
+
+  ForEachPolicy any;
+  any.mode = ForEachPolicy::ANY;
+  BehaviorTree any_tree(for_each("any clear", size, clear, any));
+  ASSERT_EQ(any_tree.run(), Status::Success);
+  ASSERT_EQ(checks, (std::vector<int>{2, 1, 0, 0}));
+
+  ForEachPolicy three;
+  three.mode = ForEachPolicy::AT_LEAST;
+  three.threshold = 3;
+  BehaviorTree three_tree(for_each("three clear", size, clear, three));
+  ASSERT_EQ(three_tree.run(), Status::Success);
+  distances[3] = 1;
+  ASSERT_EQ(three_tree.run(), Status::Failure);
+  three.threshold = 5;
+  ASSERT_EQ(BehaviorTree(for_each("five clear", size, clear, three)).run(),
+            Status::Failure);
+
+  // Empty collections: all items succeed, but none does
+  distances.clear();
+  ASSERT_EQ(all.run(), Status::Success);
+  ASSERT_EQ(any_tree.run(), Status::Failure);
+}
+
+// Subtrees are built once per index and reused as the collection changes
+TEST(BehaviorTreeTest, ForEachReusesSubtrees) {
+  std::size_t count = 2;
+  std::size_t built = 0;
+  Status item_status = Status::Running;
+  auto node = for_each(
+      "waypoints", [&] { return count; },
+      [&](std::size_t) {
+        ++built;
+        return condition([&] { return item_status; });
+      });
+  BehaviorTree tree(node);
+
+  ASSERT_EQ(tree.run(), Status::Running);
+  ASSERT_EQ(built, 2);
+  count = 5;
+  ASSERT_EQ(tree.run(), Status::Running);
+  count = 3;
+  item_status = Status::Success;
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(built, 5);
+  ASSERT_EQ(node->children().size(), 5);
+}
+
+// Large collections are spread over the pool in chunks
+TEST(BehaviorTreeTest, ForEachParallelChunks) {
+  constexpr std::size_t count = 1000;
+  std::vector<std::atomic<int>> ticks(count);
+  ForEachPolicy policy;
+  policy.chunk_size = 16;
+  policy.pool = std::make_shared<ThreadPool>(3);
+  policy.parallel_items = 100;
+  std::size_t failing = count;
+  BehaviorTree tree(for_each(
+      "obstacles", [&] { return count; },
+      [&](std::size_t i) {
+        return condition([&, i] {
+          ++ticks[i];
+          return Status(i != failing);
+        });
+      },
+      policy));
+
+  ASSERT_EQ(tree.run(), Status::Success);
+  failing = 500;
+  // All items are ticked, even after the result is decided
+  ASSERT_EQ(tree.run(), Status::Failure);
+  for (const auto &item : ticks) {
+    ASSERT_EQ(item.load(), 2);
+  }
+}
+
+// Small collections honor the tick's budget and resume where they stopped
+TEST(BehaviorTreeTest, ForEachBudget) {
+  auto clock = std::make_shared<SimulatedClock>();
+  std::vector<int> visits(4, 0);
+  BehaviorTree tree(for_each(
+      "steps", [&] { return visits.size(); },
+      [&](std::size_t i) {
+        return action([&, i] {
+          ++visits[i];
+          clock->advance(10ms);
+        });
+      }));
+  tree.set_clock(clock);
+
+  ASSERT_EQ(tree.run(15ms), Status::Incomplete);
+  ASSERT_EQ(visits, (std::vector<int>{1, 1, 0, 0}));
+  ASSERT_EQ(tree.run(1s), Status::Success);
+  ASSERT_EQ(visits, (std::vector<int>{1, 1, 1, 1}));
+}
@@ -0,0 +1,161 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Waits until the interrupt has been serviced the given number of times.
+bool wait_for_services(const Interrupt &interrupt, std::uint64_t services) {
+  for (int i = 0; i < 2000 && interrupt.stats().services < services; ++i) {
+    std::this_thread::sleep_for(1ms);
+  }
+  return interrupt.stats().services >= services;
+}
+
+} // namespace
+
+// Between ticks, the service thread ticks a triggered interrupt right away
+TEST(BehaviorTreeTest, InterruptServicedBetweenTicks) {
+  std::atomic<int> stops{0};
+  BehaviorTree tree(action([] {}));
+  auto emergency = tree.add_interrupt(
+      condition([&] {
+        ++stops;
+        return Status::Success;
+      }),
+      {});
+
+  ASSERT_EQ(emergency->last_status(), Status::Failure);
+  emergency->trigger();
+  ASSERT_TRUE(wait_for_services(*emergency, 1));
+  ASSERT_EQ(stops.load(), 1);
+  ASSERT_EQ(emergency->last_status(), Status::Success);
+  ASSERT_EQ(tree.run(), Status::Success);
+
+  tree.remove_interrupt(emergency);
+  emergency->trigger(); // Ignored after removal
+  std::this_thread::sleep_for(10ms);
+  ASSERT_EQ(stops.load(), 1);
+  ASSERT_THROW(tree.add_interrupt(nullptr), std::invalid_argument);
+}
+
+// During a tick, interrupts preempt the traversal at the next node boundary
+TEST(BehaviorTreeTest, InterruptPreemptsTick) {
+  auto clock = std::make_shared<SimulatedClock>();
+  std::vector<std::string> trace;
+  std::shared_ptr<Interrupt> low;
+  std::shared_ptr<Interrupt> high;
+  auto main_thread = std::this_thread::get_id();
+  std::thread::id serviced_by;
+
+  BehaviorTree tree;
+  tree.set_clock(clock);
+  tree.set_root(sequence(action([&] {
+                           trace.push_back("a");
+                           low->trigger();
+                           high->trigger();
+                           high->trigger(); // Coalesced
+                           clock->advance(5ms);
+                         }),
+                         action([&] { trace.push_back("b"); })));
+  low = tree.add_interrupt(action([&] { trace.push_back("low"); }));
+  high = tree.add_interrupt(action([&] {
+                              trace.push_back("high");
+                              serviced_by = std::this_thread::get_id();
+                            }),
+                            {1, 1ms});
+
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(trace, (std::vector<std::string>{"a", "high", "low", "b"}));
+  ASSERT_EQ(serviced_by, main_thread);
+
+  auto stats = high->stats();
+  ASSERT_EQ(stats.services, 1);
+  ASSERT_EQ(stats.coalesced, 1);
+  ASSERT_EQ(stats.last_latency, 5ms);
+  ASSERT_EQ(stats.max_latency, 5ms);
+  ASSERT_EQ(stats.late, 1);
+  ASSERT_EQ(low->stats().late, 0);
+}
+
+// Interrupts triggered from another thread never overlap the tree's ticks
+TEST(BehaviorTreeTest, InterruptExcludesTicks) {
+  constexpr int triggers = 2000;
+  std::atomic<bool> busy{false};
+  std::atomic<int> overlaps{0};
+  int shared_state = 0;
+  auto touch = [&] {
+    if (busy.exchange(true)) {
+      ++overlaps;
+    }
+    ++shared_state;
+    busy = false;
+  };
+  BehaviorTree tree(sequence(action(touch), action(touch), action(touch)));
+  auto interrupt = tree.add_interrupt(action(touch));
+
+  std::atomic<bool> done{false};
+  std::thread source([&] {
+    for (int i = 0; i < triggers; ++i) {
+      interrupt->trigger();
+      std::this_thread::yield();
+    }
+    done = true;
+  });
+  int ticks = 0;
+  while (!done) {
+    ASSERT_EQ(tree.run(), Status::Success);
+    ++ticks;
+  }
+  source.join();
+  auto stats = interrupt->stats();
+  ASSERT_TRUE(wait_for_services(*interrupt, triggers - stats.coalesced));
+  stats = interrupt->stats();
+  ASSERT_EQ(stats.services + stats.coalesced, triggers);
+  ASSERT_EQ(overlaps.load(), 0);
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(shared_state, 3 * (ticks + 1) + static_cast<int>(stats.services));
+}
+
+// Adding the first interrupt from another thread waits for a running tick
+TEST(BehaviorTreeTest, InterruptAddedDuringTick) {
+  std::atomic<bool> ticking{false};
+  std::atomic<bool> release{false};
+  std::atomic<bool> added{false};
+  bool added_during_tick = true;
+  BehaviorTree tree(action([&] {
+    ticking = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+    added_during_tick = added;
+  }));
+
+  std::shared_ptr<Interrupt> interrupt;
+  std::thread source([&] {
+    while (!ticking) {
+      std::this_thread::yield();
+    }
+    interrupt = tree.add_interrupt(action([] {}));
+    added = true;
+  });
+  std::thread ticker([&] { tree.run(); });
+  while (!ticking) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(10ms);
+  ASSERT_FALSE(added.load());
+  release = true;
+  ticker.join();
+  source.join();
+  ASSERT_FALSE(added_during_tick);
+
+  interrupt->trigger();
+  ASSERT_TRUE(wait_for_services(*interrupt, 1));
+}
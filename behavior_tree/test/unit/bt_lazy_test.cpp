@@ -0,0 +1,115 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <atomic>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+// Subtrees are built when first ticked and only once
+TEST(BehaviorTreeTest, LazyBuildsOnFirstTick) {
+  int built = 0;
+  int ticks = 0;
+  auto rare = lazy(
+      [&] {
+        ++built;
+        return action([&] { ++ticks; }, "recover");
+      },
+      "recovery");
+  BehaviorTree tree(fallback(condition([] { return true; }), rare));
+
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(built, 0);
+  ASSERT_FALSE(rare->built());
+  ASSERT_TRUE(rare->children().empty());
+
+  auto node = lazy([&] {
+    ++built;
+    return action([&] { ++ticks; });
+  });
+  BehaviorTree other(node);
+  ASSERT_EQ(other.run(), Status::Success);
+  ASSERT_EQ(other.run(), Status::Success);
+  ASSERT_EQ(built, 1);
+  ASSERT_EQ(ticks, 2);
+  ASSERT_EQ(node->children().size(), 1);
+
+  ASSERT_THROW(BehaviorTree(lazy([] { return BehaviorPtr(); })).run(),
+               std::runtime_error);
+  ASSERT_THROW(lazy(nullptr), std::invalid_argument);
+}
+
+// Prewarmed subtrees are built in the background and used by the next tick
+TEST(BehaviorTreeTest, LazyPrewarm) {
+  std::atomic<int> built{0};
+  auto node = lazy([&] {
+    ++built;
+    return condition([] { return Status::Running; });
+  });
+  node->prewarm();
+  node->prewarm(); // Already being built
+  BehaviorTree tree(node);
+
+  ASSERT_EQ(tree.run(), Status::Running);
+  ASSERT_EQ(built.load(), 1);
+  node->prewarm(); // Already built
+  ASSERT_EQ(tree.run(), Status::Running);
+  ASSERT_EQ(built.load(), 1);
+}
+
+// Subtrees which were not ticked for their idle timeout are freed
+TEST(BehaviorTreeTest, LazyReleasesIdleSubtrees) {
+  auto clock = std::make_shared<SimulatedClock>();
+  int built = 0;
+  bool use = true;
+  auto builder = [&] {
+    ++built;
+    return action([] {});
+  };
+  auto idle = lazy(builder, "idle", 1s, clock);
+  auto kept = lazy(builder, "kept", Clock::Duration::zero(), clock);
+  auto root = sequence(condition([&] { return use; }), idle, kept);
+  BehaviorTree tree(root);
+
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(built, 2);
+  clock->advance(500ms);
+  ASSERT_EQ(Lazy::release_idle(root), 0);
+
+  use = false;
+  ASSERT_EQ(tree.run(), Status::Failure);
+  clock->advance(1s);
+  ASSERT_EQ(Lazy::release_idle(root), 1);
+  ASSERT_FALSE(idle->built());
+  ASSERT_TRUE(kept->built());
+
+  use = true;
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(built, 3);
+}
+
+// Lazy nodes report one idle deadline per idle period, not one per tick
+TEST(BehaviorTreeTest, LazyReportsIdleDeadlineOncePerPeriod) {
+  auto clock = std::make_shared<SimulatedClock>();
+  auto node = lazy([] { return action([] {}); }, "idle", 1s, clock);
+  BehaviorTree tree(node);
+  tree.set_clock(clock);
+
+  ASSERT_EQ(tree.run(), Status::Success);
+  auto first = clock->now() + 1s;
+  for (int i = 0; i < 5; ++i) {
+    clock->advance(100ms);
+    ASSERT_EQ(tree.run(), Status::Success);
+    ASSERT_EQ(clock->next_deadline(), first);
+  }
+  auto expiry = clock->now() + 1s;
+
+  // Woken before the node is idle, release_idle() reports the real expiry
+  ASSERT_TRUE(clock->advance_to_next_deadline());
+  ASSERT_EQ(Lazy::release_idle(node), 0);
+  ASSERT_EQ(clock->next_deadline(), expiry);
+  ASSERT_TRUE(clock->advance_to_next_deadline());
+  ASSERT_EQ(Lazy::release_idle(node), 1);
+  ASSERT_FALSE(node->built());
+}
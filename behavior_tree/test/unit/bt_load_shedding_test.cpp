@@ -0,0 +1,73 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+// Low priority subtrees are skipped under overload and come back with
+// hysteresis once the load falls
+TEST(BehaviorTreeTest, LoadShedding) {
+  auto clock = std::make_shared<SimulatedClock>();
+  auto control_time = 9ms;
+  size_t telemetry_visits = 0;
+  BehaviorTree bt(sequence(action([&] { clock->advance(control_time); },
+                                  "Control"),
+                           with_priority(0, action([&] {
+                                           ++telemetry_visits;
+                                           clock->advance(1ms);
+                                         },
+                                                   "Telemetry"))));
+  bt.set_clock(clock);
+
+  LoadSheddingPolicy policy;
+  policy.period = 10ms;
+  policy.threshold = 1;
+  policy.shed_status = Status::Success;
+  policy.smoothing = 1.0; // Only the last tick counts
+  bt.set_load_shedding(policy);
+
+  // The first tick overruns the period
+  ASSERT_EQ(bt.run(), Status::Success);
+  ASSERT_EQ(telemetry_visits, 1);
+  ASSERT_TRUE(bt.load_shedder()->active());
+
+  // The load stays above the recovery fraction
+  ASSERT_EQ(bt.run(), Status::Success);
+  ASSERT_EQ(telemetry_visits, 1);
+  ASSERT_TRUE(bt.load_shedder()->active());
+
+  // The load falls below the recovery fraction
+  control_time = 2ms;
+  ASSERT_EQ(bt.run(), Status::Success);
+  ASSERT_EQ(telemetry_visits, 1);
+  ASSERT_FALSE(bt.load_shedder()->active());
+
+  ASSERT_EQ(bt.run(), Status::Success);
+  ASSERT_EQ(telemetry_visits, 2);
+  ASSERT_EQ(bt.load_shedder()->shed_counts(),
+            (std::map<int, std::uint64_t>{{0, 2}}));
+}
+
+// Nodes without a priority are never shed
+TEST(BehaviorTreeTest, LoadSheddingKeepsCriticalNodes) {
+  auto clock = std::make_shared<SimulatedClock>();
+  size_t visits = 0;
+  BehaviorTree bt(action([&] {
+    ++visits;
+    clock->advance(1s);
+  }));
+  bt.set_clock(clock);
+
+  LoadSheddingPolicy policy;
+  policy.period = 10ms;
+  policy.threshold = 100;
+  bt.set_load_shedding(policy);
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(bt.run(), Status::Success);
+  }
+  ASSERT_EQ(visits, 3);
+  ASSERT_TRUE(bt.load_shedder()->shed_counts().empty());
+}
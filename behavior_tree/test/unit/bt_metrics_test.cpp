@@ -0,0 +1,161 @@
+#include "../include/behavior_tree/bt_base.h"
+#include "stepping_clock.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+namespace {
+
+bool contains(const std::string &text, const std::string &line) {
+  return text.find(line + "\n") != std::string::npos;
+}
+
+} // namespace
+
+// Ticks, durations, visits and statuses are exposed per tree and node
+TEST(BehaviorTreeTest, MetricsCountTreeAndNodes) {
+  Status input = Status::Success;
+  auto check = condition([&input] { return input; }, "Check \"lane\"");
+  auto root = sequence("root", check, action([] {}, "drive"));
+  BehaviorTree tree(root);
+  tree.set_clock(std::make_shared<SteppingClock>());
+  MetricsRegistry registry;
+  auto metrics = tree.enable_metrics("planner", registry);
+
+  tree.run();
+  tree.run();
+  input = Status::Failure;
+  tree.run();
+
+  ASSERT_EQ(metrics->ticks(), 3);
+  ASSERT_EQ(metrics->visits(*root), 3);
+  ASSERT_EQ(metrics->visits(*check), 3);
+  ASSERT_EQ(metrics->count(*root, Status::Success), 2);
+  ASSERT_EQ(metrics->count(*root, Status::Failure), 1);
+  ASSERT_EQ(metrics->visits(*root->children()[1]), 2);
+
+  auto text = registry.scrape();
+  ASSERT_TRUE(contains(text, "# TYPE bt_ticks_total counter"));
+  ASSERT_TRUE(contains(text, "bt_ticks_total{tree=\"planner\"} 3"));
+  ASSERT_TRUE(contains(text, "# TYPE bt_tick_duration_seconds histogram"));
+  ASSERT_TRUE(contains(
+      text,
+      "bt_tick_duration_seconds_bucket{tree=\"planner\",le=\"0.0005\"} 0"));
+  ASSERT_TRUE(contains(
+      text,
+      "bt_tick_duration_seconds_bucket{tree=\"planner\",le=\"0.005\"} 3"));
+  ASSERT_TRUE(contains(
+      text, "bt_tick_duration_seconds_bucket{tree=\"planner\",le=\"+Inf\"} 3"));
+  ASSERT_TRUE(
+      contains(text, "bt_tick_duration_seconds_sum{tree=\"planner\"} 0.003"));
+  ASSERT_TRUE(
+      contains(text, "bt_tick_duration_seconds_count{tree=\"planner\"} 3"));
+  ASSERT_TRUE(contains(text, "bt_node_visits_total{tree=\"planner\",node=\"1\","
+                             "type=\"condition\",description=\"Check "
+                             "\\\"lane\\\"\"} 3"));
+  ASSERT_TRUE(contains(text, "bt_node_status_total{tree=\"planner\",node=\"0\","
+                             "status=\"failure\"} 1"));
+
+  // Disabled metrics disappear from the registry
+  tree.disable_metrics();
+  tree.run();
+  ASSERT_EQ(metrics->ticks(), 3);
+  ASSERT_EQ(registry.scrape(), "");
+}
+
+// Families shared by several trees are announced once
+TEST(BehaviorTreeTest, MetricsMergeFamilies) {
+  BehaviorTree first(action([] {}));
+  BehaviorTree second(action([] {}));
+  MetricsRegistry registry;
+  first.enable_metrics("first", registry);
+  auto metrics = second.enable_metrics("second", registry);
+  first.run();
+
+  auto text = registry.scrape();
+  auto help = text.find("# HELP bt_ticks_total");
+  ASSERT_NE(help, std::string::npos);
+  ASSERT_EQ(text.find("# HELP bt_ticks_total", help + 1), std::string::npos);
+  ASSERT_TRUE(contains(text, "bt_ticks_total{tree=\"first\"} 1"));
+  ASSERT_TRUE(contains(text, "bt_ticks_total{tree=\"second\"} 0"));
+
+  // A new root restarts the counts
+  second.run();
+  auto root = sequence(action([] {}), action([] {}));
+  second.set_root(root);
+  ASSERT_EQ(metrics->ticks(), 0);
+  second.run();
+  ASSERT_EQ(metrics->visits(*root), 1);
+}
+
+// Nodes freed while the tree runs keep their labels but are no longer counted
+TEST(BehaviorTreeTest, MetricsOutliveFreedNodes) {
+  auto removed = action([] {}, "removed");
+  auto jobs = dynamic_sequence(removed);
+  BehaviorTree tree(jobs);
+  MetricsRegistry registry;
+  auto metrics = tree.enable_metrics("jobs", registry);
+  tree.run();
+
+  jobs->remove(removed);
+  removed.reset();
+  auto added = action([] {}, "added");
+  jobs->append(added);
+  tree.run();
+  ASSERT_EQ(metrics->visits(*jobs), 2);
+  ASSERT_EQ(metrics->visits(*added), 0);
+  ASSERT_TRUE(contains(registry.scrape(),
+                       "bt_node_visits_total{tree=\"jobs\",node=\"1\","
+                       "type=\"action\",description=\"removed\"} 1"));
+}
+
+// Exceptions and restarts of memory nodes are counted by the library
+TEST(BehaviorTreeTest, MetricsCountLibraryEvents) {
+  auto &library = library_metrics();
+  auto actions = library.value(LibraryMetrics::ACTION_EXCEPTIONS);
+  auto conditions = library.value(LibraryMetrics::CONDITION_EXCEPTIONS);
+  auto restarts = library.value(LibraryMetrics::MEMORY_RESTARTS);
+
+  BehaviorTree tree(sequence_memory(
+      fallback(condition(
+                   []() -> Status { throw std::runtime_error("sensor"); }),
+               action([] {})),
+      fallback(action([] { throw std::runtime_error("motor"); }),
+               action([] {}))));
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(tree.run(), Status::Success);
+
+  ASSERT_EQ(library.value(LibraryMetrics::ACTION_EXCEPTIONS), actions + 2);
+  ASSERT_EQ(library.value(LibraryMetrics::CONDITION_EXCEPTIONS),
+            conditions + 2);
+  ASSERT_EQ(library.value(LibraryMetrics::MEMORY_RESTARTS), restarts + 2);
+  ASSERT_NE(MetricsRegistry::global().scrape().find(
+                "# TYPE bt_memory_node_restarts_total counter"),
+            std::string::npos);
+}
+
+// Increments from several threads land in different shards and are summed
+TEST(BehaviorTreeTest, MetricsShardedCounters) {
+  ShardedCounters counters(3);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&counters] {
+      for (int i = 0; i < 10000; ++i) {
+        counters.add(1);
+        counters.add(2, 2);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(counters.size(), 3);
+  ASSERT_EQ(counters.value(0), 0);
+  ASSERT_EQ(counters.value(1), 80000);
+  ASSERT_EQ(counters.value(2), 160000);
+}
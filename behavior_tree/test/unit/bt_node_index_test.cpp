@@ -0,0 +1,46 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+// Nodes are numbered depth-first from the root, shared nodes once
+TEST(BehaviorTreeTest, NodeIndexNumbersDepthFirst) {
+  auto shared = action([] {});
+  auto left = sequence(shared, action([] {}));
+  auto root = fallback(left, shared);
+  NodeIndex index(root);
+
+  ASSERT_EQ(index.size(), 4);
+  ASSERT_EQ(index.find(*root), 0u);
+  ASSERT_EQ(index.find(*left), 1u);
+  ASSERT_EQ(index.find(*shared), 2u);
+  ASSERT_EQ(index.find(*left->children()[1]), 3u);
+  ASSERT_EQ(index.node(2), shared);
+  ASSERT_EQ(index.node(4), nullptr);
+  ASSERT_FALSE(index.find(*action([] {})));
+  ASSERT_EQ(NodeIndex(nullptr).size(), 0);
+}
+
+// Indices over the same nodes stay valid, and copies of nodes are not found
+TEST(BehaviorTreeTest, NodeIndexSharedNodes) {
+  auto leaf = action([] {});
+  auto first_root = sequence(leaf);
+  NodeIndex first(first_root);
+  auto second_root = sequence(action([] {}), leaf);
+  NodeIndex second(second_root);
+  ASSERT_NE(first.generation(), second.generation());
+
+  ASSERT_EQ(first.find(*leaf), 1u);
+  ASSERT_EQ(second.find(*leaf), 2u);
+  auto copy = std::make_shared<Action>(*std::static_pointer_cast<Action>(leaf));
+  ASSERT_FALSE(first.find(*copy));
+  ASSERT_FALSE(second.find(*copy));
+
+  // A freed node is no longer found
+  first_root->replace_child(0, action([] {}));
+  second_root->replace_child(1, action([] {}));
+  leaf.reset();
+  ASSERT_EQ(first.node(1), nullptr);
+}
@@ -0,0 +1,86 @@
+#include "../include/behavior_tree/bt_base.h"
+#include "../include/behavior_tree/perf_counters.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+namespace {
+
+// Records the enter and exit notifications of a tick.
+class Recorder : public TickObserver {
+public:
+  void on_enter(const BehaviorNode &node) override {
+    events.push_back("enter " + node.description());
+  }
+
+  void on_exit(const BehaviorNode &node, Status status) override {
+    std::ostringstream event;
+    event << "exit " << node.description() << " " << status;
+    events.push_back(event.str());
+  }
+
+  std::vector<std::string> events;
+};
+
+} // namespace
+
+// Observers see every ticked node, the root included
+TEST(BehaviorTreeTest, TickObserverOrder) {
+  auto recorder = std::make_shared<Recorder>();
+  BehaviorTree tree(
+      fallback("root", condition([] { return Status::Failure; }, "a"),
+               condition([] { return Status::Success; }, "b")));
+  tree.add_observer(recorder);
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(recorder->events,
+            (std::vector<std::string>{"enter root", "enter a", "exit a FAILURE",
+                                      "enter b", "exit b SUCCESS",
+                                      "exit root SUCCESS"}));
+
+  tree.remove_observer(recorder);
+  recorder->events.clear();
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_TRUE(recorder->events.empty());
+}
+
+// Counters are attributed to nodes, with or without hardware support
+TEST(BehaviorTreeTest, PerfCountersPerNode) {
+  auto counters = std::make_shared<PerfCounters>();
+  auto leaf = condition([] {
+    volatile int sum = 0;
+    for (int i = 0; i < 1000; ++i) {
+      sum += i;
+    }
+    return Status::Success;
+  });
+  auto root = sequence(leaf, leaf);
+  BehaviorTree tree(root);
+  tree.add_observer(counters);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(tree.run(), Status::Success);
+  }
+
+  const auto &nodes = counters->nodes();
+  ASSERT_EQ(nodes.at(root.get()).ticks, 10);
+  ASSERT_EQ(nodes.at(leaf.get()).ticks, 20);
+  if (!counters->available()) {
+    ASSERT_TRUE(counters->events().empty());
+    ASSERT_EQ(nodes.at(root.get()).inclusive, PerfCounters::Counts{});
+    return;
+  }
+  for (auto event : counters->events()) {
+    const auto &root_counters = nodes.at(root.get());
+    const auto &leaf_counters = nodes.at(leaf.get());
+    ASSERT_GE(root_counters.inclusive[event],
+              root_counters.exclusive[event] + leaf_counters.inclusive[event])
+        << PerfCounters::name(event);
+    ASSERT_EQ(leaf_counters.inclusive[event], leaf_counters.exclusive[event]);
+  }
+  ASSERT_GT(nodes.at(leaf.get()).inclusive[PerfCounters::INSTRUCTIONS], 0);
+
+  counters->clear();
+  ASSERT_TRUE(counters->nodes().empty());
+}
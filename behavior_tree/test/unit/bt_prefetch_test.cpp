@@ -0,0 +1,106 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+// Every task of a batch runs exactly once
+TEST(BehaviorTreeTest, ThreadPoolRunsEachTaskOnce) {
+  for (size_t workers : {0, 1, 4}) {
+    ThreadPool pool(workers);
+    std::vector<std::atomic<int>> runs(100);
+    for (int batch = 0; batch < 10; ++batch) {
+      pool.parallel_for(runs.size(), [&runs](size_t i) { ++runs[i]; });
+    }
+    for (auto &count : runs) {
+      ASSERT_EQ(count, 10);
+    }
+  }
+}
+
+// An exception thrown by a task reaches the caller
+TEST(BehaviorTreeTest, ThreadPoolRethrows) {
+  ThreadPool pool(2);
+  ASSERT_THROW(pool.parallel_for(10,
+                                 [](size_t i) {
+                                   if (i == 3) {
+                                     throw std::runtime_error("task");
+                                   }
+                                 }),
+               std::runtime_error);
+  // The pool stays usable
+  std::atomic<int> runs{0};
+  pool.parallel_for(5, [&runs](size_t) { ++runs; });
+  ASSERT_EQ(runs, 5);
+}
+
+// Prefetchable conditions are evaluated concurrently before the tick
+TEST(BehaviorTreeTest, PrefetchEvaluatesConditionsConcurrently) {
+  constexpr int checks = 4;
+  std::atomic<int> arrived{0};
+  // Each check succeeds only if all of them are evaluated at the same time
+  auto check = [&arrived] {
+    ++arrived;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (arrived < checks && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    return Status(arrived >= checks);
+  };
+  BehaviorTree tree(sequence(prefetchable_condition(check),
+                             prefetchable_condition(check),
+                             prefetchable_condition(check),
+                             prefetchable_condition(check)));
+  tree.set_prefetching(std::make_shared<ThreadPool>(checks - 1));
+  ASSERT_EQ(tree.run(), Status::Success);
+}
+
+// Control nodes resolve from the batch and only the chosen actions run
+TEST(BehaviorTreeTest, PrefetchResolvesFromSnapshot) {
+  int live = 0;
+  int snapshot = 0;
+  size_t evaluations = 0;
+  size_t side_effects = 0;
+  std::vector<int> actions;
+  auto positive = prefetchable_condition([&] {
+    ++evaluations;
+    return Status(snapshot > 0);
+  });
+  auto impure = condition([&side_effects] {
+    ++side_effects;
+    return Status::Success;
+  });
+  BehaviorTree tree(fallback(
+      sequence(positive, action([&] { live = -1; }), positive,
+               action([&actions] { actions.push_back(1); })),
+      sequence(impure, action([&actions] { actions.push_back(2); }))));
+  tree.set_prefetching(std::make_shared<ThreadPool>(2),
+                       [&] { snapshot = live; });
+
+  live = 1;
+  ASSERT_EQ(tree.run(), Status::Success);
+  // The action changed the live value, but the tick kept the snapshot
+  ASSERT_EQ(actions, std::vector<int>{1});
+  ASSERT_EQ(evaluations, 1);
+  ASSERT_EQ(side_effects, 0);
+
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(actions, (std::vector<int>{1, 2}));
+  ASSERT_EQ(evaluations, 2);
+  ASSERT_EQ(side_effects, 1);
+
+  // Outside the tick the condition is evaluated again
+  snapshot = 1;
+  ASSERT_EQ((*positive)(), Status::Success);
+  ASSERT_EQ(evaluations, 3);
+
+  tree.disable_prefetching();
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(evaluations, 5);
+}
@@ -0,0 +1,97 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+#include <map>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+// A long mission only instantiates a window of its children and recycles them
+TEST(BehaviorTreeTest, ProceduralSequenceMission) {
+  constexpr std::size_t waypoints = 20000;
+  std::size_t built = 0;
+  std::vector<std::size_t> logged;
+  // The waypoint of each built subtree, which recycling retargets
+  std::map<const BehaviorNode *, std::shared_ptr<std::size_t>> targets;
+
+  auto mission = procedural_sequence(
+      "mission", waypoints,
+      [&](std::size_t index, BehaviorPtr recycled) {
+        if (recycled) {
+          *targets.at(recycled.get()) = index;
+          return recycled;
+        }
+        ++built;
+        auto target = std::make_shared<std::size_t>(index);
+        auto subtree = sequence(
+            "waypoint", action([] {}, "approach"),
+            condition([] { return Status::Success; }, "verify"),
+            action([&logged, target] { logged.push_back(*target); }, "log"));
+        targets[subtree.get()] = target;
+        return subtree;
+      },
+      2);
+  BehaviorTree tree(mission);
+
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(logged.size(), waypoints);
+  ASSERT_EQ(logged[0], 0);
+  ASSERT_EQ(logged[12345], 12345);
+  ASSERT_EQ(logged.back(), waypoints - 1);
+  // Only the window and the pool were ever built
+  ASSERT_LE(built, 4);
+  ASSERT_EQ(mission->children().size(), 2);
+  ASSERT_EQ(mission->current(), 0);
+
+  // Children which are not instantiated can be inspected
+  ASSERT_EQ(mission->size(), waypoints);
+  ASSERT_EQ(mission->child(500)->children().size(), 3);
+  ASSERT_THROW(mission->child(waypoints), std::out_of_range);
+}
+
+// The current child is kept until it succeeds, like SequenceMemory
+TEST(BehaviorTreeTest, ProceduralSequenceKeepsCurrentChild) {
+  std::vector<Status> results{Status::Success, Status::Running,
+                              Status::Success};
+  std::vector<int> ticks(results.size(), 0);
+  auto node = procedural_sequence(
+      "steps", results.size(), [&](std::size_t index, BehaviorPtr) {
+        return condition([&, index] {
+          ++ticks[index];
+          return results[index];
+        });
+      });
+  BehaviorTree tree(node);
+
+  ASSERT_EQ(tree.run(), Status::Running);
+  ASSERT_EQ(tree.run(), Status::Running);
+  ASSERT_EQ(ticks, (std::vector<int>{1, 2, 0}));
+  ASSERT_EQ(node->current(), 1);
+
+  results[1] = Status::Success;
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(ticks, (std::vector<int>{1, 3, 1}));
+  ASSERT_EQ(node->children().size(), 1);
+}
+
+// A procedural fallback tries generated alternatives until one succeeds
+TEST(BehaviorTreeTest, ProceduralFallbackAlternatives) {
+  std::size_t working = 3;
+  std::vector<std::size_t> tried;
+  BehaviorTree tree(procedural_fallback(
+      "grasps", 5, [&](std::size_t index, BehaviorPtr) {
+        return condition([&, index] {
+          tried.push_back(index);
+          return Status(index == working);
+        });
+      }));
+
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(tried, (std::vector<std::size_t>{0, 1, 2, 3}));
+  working = 10;
+  tried.clear();
+  // Memory keeps the successful alternative, then all fail
+  ASSERT_EQ(tree.run(), Status::Failure);
+  ASSERT_EQ(tried, (std::vector<std::size_t>{3, 4}));
+  ASSERT_THROW(procedural_fallback("empty", 1, nullptr), std::invalid_argument);
+}
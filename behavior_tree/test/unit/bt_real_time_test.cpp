@@ -0,0 +1,149 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+#include <memory_resource>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Ticks trees in real-time mode and checks that no tick allocates.
+class RealTimeTest : public Test {
+protected:
+  void SetUp() override {
+    // The test binary is linked with the allocation hooks
+    ASSERT_TRUE(AllocationGuard::available());
+  }
+
+  // Ticks the tree several times and expects no allocations at all.
+  void expect_allocation_free(BehaviorPtr root, Status expected,
+                              const RealTimePolicy &policy = counting()) {
+    BehaviorTree tree(std::move(root));
+    ASSERT_TRUE(tree.set_real_time(policy));
+    for (int i = 0; i < 5; ++i) {
+      ASSERT_EQ(tree.run(), expected);
+    }
+    ASSERT_EQ(tree.tick_allocations(), 0);
+  }
+
+  static RealTimePolicy counting() {
+    RealTimePolicy policy;
+    policy.on_allocation = AllocationGuard::COUNT;
+    return policy;
+  }
+
+  BehaviorPtr success = action([] {});
+  BehaviorPtr failure = condition([] { return false; });
+  BehaviorPtr running = condition([] { return Status::Running; });
+};
+
+} // namespace
+
+TEST_F(RealTimeTest, Leaves) {
+  expect_allocation_free(success, Status::Success);
+  expect_allocation_free(failure, Status::Failure);
+  expect_allocation_free(prefetchable_condition([] { return true; }),
+                         Status::Success);
+  expect_allocation_free(
+      action([](TickContext &context) { ASSERT_GT(context.tick(), 0); }),
+      Status::Success);
+  expect_allocation_free(
+      condition([](TickContext &) { return Status::Running; }),
+      Status::Running);
+}
+
+TEST_F(RealTimeTest, Composites) {
+  expect_allocation_free(sequence(success, success, failure), Status::Failure);
+  expect_allocation_free(fallback(failure, running, success), Status::Running);
+  expect_allocation_free(sequence_memory(success, running), Status::Running);
+  expect_allocation_free(fallback_memory(failure, success), Status::Success);
+  expect_allocation_free(skipper(running, failure), Status::Failure);
+  expect_allocation_free(parallel(success, running, failure), Status::Running);
+  expect_allocation_free(unordered_sequence(success, failure), Status::Failure);
+  expect_allocation_free(unordered_fallback(failure, success), Status::Success);
+  expect_allocation_free(try_else("try", failure, success), Status::Success);
+  expect_allocation_free(if_then("if", success, running), Status::Running);
+  expect_allocation_free(if_then_else("if", failure, failure, success),
+                         Status::Success);
+  expect_allocation_free(
+      boolean_formula(fallback(failure, sequence(not_(failure), failure),
+                               condition([] { return true; }))),
+      Status::Success);
+}
+
+TEST_F(RealTimeTest, Decorators) {
+  auto [latch, unlatch] = latch_and_unlatch(success);
+  expect_allocation_free(sequence(latch, unlatch), Status::Success);
+  expect_allocation_free(not_(failure), Status::Success);
+  expect_allocation_free(throttle(success, 1s), Status::Success);
+  expect_allocation_free(cached(failure, 1s), Status::Failure);
+  expect_allocation_free(with_priority(1, success), Status::Success);
+  // The subtree is built when real-time mode is enabled
+  expect_allocation_free(lazy([] { return sequence(action([] {})); }),
+                         Status::Success);
+}
+
+TEST_F(RealTimeTest, GeneratedChildren) {
+  auto generate = [this](std::size_t, BehaviorPtr recycled) {
+    return recycled ? recycled : success;
+  };
+  expect_allocation_free(procedural_sequence("steps", 1, generate),
+                         Status::Success);
+  expect_allocation_free(procedural_fallback("options", 3, generate, 3),
+                         Status::Success);
+  expect_allocation_free(dynamic_sequence(success, success), Status::Success);
+  expect_allocation_free(dynamic_fallback(failure, running), Status::Running);
+  ForEachPolicy half;
+  half.mode = ForEachPolicy::AT_LEAST;
+  half.threshold = 50;
+  expect_allocation_free(
+      for_each(
+          "items", [] { return 100; },
+          [this](std::size_t i) { return i % 2 ? success : failure; }, half),
+      Status::Success);
+}
+
+// Temporary allocations from the scratch arena do not reach the heap
+TEST_F(RealTimeTest, ScratchArena) {
+  auto policy = counting();
+  policy.scratch_bytes = 1 << 20;
+  policy.prefault_stack = 256 * 1024;
+  expect_allocation_free(action([](TickContext &context) {
+                           std::pmr::vector<double> samples(&context.scratch());
+                           samples.resize(100000);
+                         }),
+                         Status::Success, policy);
+}
+
+// Pre-faulting the heap changes the malloc settings of the whole process, so
+// it runs in a child process
+TEST_F(RealTimeTest, PrefaultHeap) {
+  RealTimePolicy policy;
+  policy.prefault_heap = 1 << 20;
+  EXPECT_EXIT(std::exit(prepare_real_time_memory(policy) ? 0 : 1),
+              ExitedWithCode(0), "");
+}
+
+// Allocations during a tick are counted, or abort the process
+TEST_F(RealTimeTest, Violations) {
+  std::vector<std::unique_ptr<int>> leaks;
+  BehaviorTree tree(action([&] { leaks.push_back(std::make_unique<int>()); }));
+  tree.set_real_time(counting());
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_GE(tree.tick_allocations(), 2);
+
+  // Allocations outside ticks and outside real-time mode are not counted
+  auto allocations = tree.tick_allocations();
+  leaks.clear();
+  leaks.reserve(10);
+  tree.disable_real_time();
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(tree.tick_allocations(), allocations);
+
+  auto policy = counting();
+  policy.on_allocation = AllocationGuard::ABORT;
+  tree.set_real_time(policy);
+  ASSERT_DEATH(tree.run(), "heap allocation during a real-time tick");
+}
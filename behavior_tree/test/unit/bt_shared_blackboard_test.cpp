@@ -0,0 +1,107 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+namespace {
+
+struct Pose {
+  double x;
+  double y;
+  double z;
+};
+
+std::string segment_name(const std::string &test) {
+  return "/evo_bt_" + test + "_" + std::to_string(getpid());
+}
+
+} // namespace
+
+// Values written through one mapping are read through another
+TEST(BehaviorTreeTest, SharedBlackboardSlots) {
+  BlackboardLayout layout;
+  auto speed = layout.add<double>("speed");
+  auto pose = layout.add<Pose>("pose");
+  ASSERT_THROW(layout.add<int>("speed"), std::invalid_argument);
+  // Slots do not share cache lines
+  ASSERT_EQ(speed.offset() % 64, 0);
+  ASSERT_GE(pose.offset(), speed.offset() + 64);
+
+  auto name = segment_name("blackboard_slots");
+  SharedBlackboard writer(name, layout);
+  SharedBlackboard reader(name);
+  ASSERT_EQ(reader.slots().size(), 2);
+  ASSERT_EQ(reader.slots()[1].name, "pose");
+
+  auto read_speed = reader.slot<double>("speed");
+  auto read_pose = reader.slot<Pose>("pose");
+  ASSERT_EQ(reader.read(read_speed), 0.0);
+  ASSERT_EQ(reader.writes(read_speed), 0);
+
+  writer.write(speed, 12.5);
+  writer.write(pose, Pose{1, 2, 3});
+  ASSERT_EQ(reader.read(read_speed), 12.5);
+  ASSERT_EQ(reader.writes(read_speed), 1);
+  Pose value{};
+  ASSERT_TRUE(reader.try_read(read_pose, value));
+  ASSERT_EQ(value.y, 2);
+
+  ASSERT_THROW(reader.slot<float>("speed"), std::invalid_argument);
+  ASSERT_THROW(reader.slot<double>("heading"), std::out_of_range);
+  ASSERT_THROW(SharedBlackboard(segment_name("blackboard_missing")),
+               std::system_error);
+}
+
+// Conditions bound to slots decide on the latest values
+TEST(BehaviorTreeTest, SharedBlackboardCondition) {
+  BlackboardLayout layout;
+  auto distance = layout.add<double>("obstacle_distance");
+  auto name = segment_name("blackboard_condition");
+  SharedBlackboard perception(name, layout);
+  auto board = std::make_shared<const SharedBlackboard>(name);
+
+  int braked = 0;
+  BehaviorTree tree(
+      fallback(blackboard_condition(
+                   board, board->slot<double>("obstacle_distance"),
+                   [](double meters) { return meters > 10.0; }, "clear"),
+               action([&braked] { ++braked; })));
+
+  perception.write(distance, 50.0);
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(braked, 0);
+  perception.write(distance, 5.0);
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(braked, 1);
+}
+
+// Readers never see a partially written value
+TEST(BehaviorTreeTest, SharedBlackboardConsistentReads) {
+  BlackboardLayout layout;
+  auto pose = layout.add<Pose>("pose");
+  auto name = segment_name("blackboard_consistent");
+  SharedBlackboard writer(name, layout);
+  SharedBlackboard reader(name);
+
+  std::atomic<bool> done{false};
+  std::thread producer([&] {
+    for (double i = 1; i <= 100000; ++i) {
+      writer.write(pose, Pose{i, i, i});
+    }
+    done = true;
+  });
+  while (!done) {
+    auto value = reader.read(pose);
+    ASSERT_EQ(value.x, value.y);
+    ASSERT_EQ(value.y, value.z);
+  }
+  producer.join();
+  ASSERT_EQ(reader.read(pose).z, 100000);
+  ASSERT_EQ(reader.writes(pose), 100000);
+}
@@ -0,0 +1,63 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+// The simulated clock moves forward only, by steps or to deadlines
+TEST(BehaviorTreeTest, SimulatedClockDeadlines) {
+  auto start = Clock::TimePoint(1h);
+  SimulatedClock clock(start);
+  ASSERT_EQ(clock.now(), start);
+  ASSERT_FALSE(clock.next_deadline());
+
+  clock.add_deadline(start + 5s);
+  clock.add_deadline(start + 2s);
+  clock.add_deadline(start); // Not in the future
+  ASSERT_EQ(clock.next_deadline(), start + 2s);
+  clock.advance(3s);
+  ASSERT_EQ(clock.next_deadline(), start + 5s);
+  ASSERT_TRUE(clock.advance_to_next_deadline());
+  ASSERT_EQ(clock.now(), start + 5s);
+
+  // Without deadlines before the limit, the clock moves to the limit
+  clock.add_deadline(start + 1min);
+  ASSERT_FALSE(clock.advance_to_next_deadline(start + 10s));
+  ASSERT_EQ(clock.now(), start + 10s);
+  ASSERT_THROW(clock.advance(-1s), std::invalid_argument);
+  ASSERT_THROW(clock.advance_to(start), std::invalid_argument);
+  clock.advance_to(start + 2min);
+  ASSERT_FALSE(clock.next_deadline());
+}
+
+// A shift of eight hours is replayed by jumping between the nodes' deadlines
+TEST(BehaviorTreeTest, SimulatedClockReplaysShift) {
+  auto clock = std::make_shared<SimulatedClock>();
+  set_default_clock(clock);
+  int picks = 0;
+  int inspections = 0;
+  // Nodes and trees created now use the simulated clock
+  BehaviorTree tree(sequence(
+      throttle(action([&] { ++picks; }), 1min),
+      cached(condition([&] {
+               ++inspections;
+               return true;
+             }),
+             15min)));
+  set_default_clock(nullptr);
+  ASSERT_NE(default_clock(), clock);
+
+  auto end = clock->now() + 8h;
+  int ticks = 0;
+  while (clock->now() < end) {
+    ASSERT_EQ(tree.run(), Status::Success);
+    ++ticks;
+    clock->advance_to_next_deadline(end);
+  }
+  ASSERT_EQ(picks, 8 * 60);
+  ASSERT_EQ(inspections, 8 * 4);
+  ASSERT_EQ(ticks, 8 * 60);
+  ASSERT_EQ(tree.context().now(), end - 1min);
+}
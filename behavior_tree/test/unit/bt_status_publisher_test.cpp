@@ -0,0 +1,99 @@
+#include "../include/behavior_tree/bt_base.h"
+#include "../include/behavior_tree/status_publisher.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+namespace {
+
+std::string segment_name(const std::string &test) {
+  return "/evo_bt_" + test + "_" + std::to_string(getpid());
+}
+
+} // namespace
+
+// Readers see the topology and the statuses of the latest tick
+TEST(BehaviorTreeTest, StatusPublisherSnapshot) {
+  Status first = Status::Failure;
+  auto shared = condition([] { return Status::Success; }, "shared");
+  auto root = fallback("root", condition([&first] { return first; }, "first"),
+                       sequence(shared, shared));
+  auto name = segment_name("snapshot");
+  BehaviorTree tree(root);
+  auto publisher = std::make_shared<StatusPublisher>(name, tree.node_index());
+  tree.add_observer(publisher);
+
+  StatusReader reader(name);
+  const auto &topology = reader.topology();
+  ASSERT_EQ(topology.size(), 4);
+  ASSERT_EQ(topology[0].description, "root");
+  ASSERT_EQ(topology[0].children, (std::vector<std::uint32_t>{1, 2}));
+  ASSERT_EQ(topology[1].description, "first");
+  ASSERT_EQ(topology[2].type, "sequence");
+  ASSERT_EQ(topology[2].children, (std::vector<std::uint32_t>{3, 3}));
+  ASSERT_EQ(topology[3].description, "shared");
+
+  StatusReader::Snapshot snapshot;
+  reader.read(snapshot);
+  ASSERT_EQ(snapshot.tick, 0);
+
+  ASSERT_EQ(tree.run(), Status::Success);
+  first = Status::Running;
+  ASSERT_EQ(tree.run(), Status::Running);
+  reader.read(snapshot);
+  ASSERT_EQ(snapshot.tick, 2);
+  ASSERT_EQ(snapshot.statuses,
+            (std::vector<Status>{Status::Running, Status::Running,
+                                 Status::Success, Status::Success}));
+  ASSERT_EQ(snapshot.last_ticks, (std::vector<std::uint64_t>{2, 2, 1, 1}));
+}
+
+// Concurrent readers only ever see the state of a whole tick
+TEST(BehaviorTreeTest, StatusPublisherConsistentReads) {
+  int tick = 0;
+  auto root = parallel(condition([&tick] { return Status(tick % 2 == 0); }),
+                       condition([&tick] { return Status(tick % 2 == 0); }));
+  auto name = segment_name("consistent");
+  auto publisher = std::make_shared<StatusPublisher>(name, root);
+  BehaviorTree tree(root);
+  tree.add_observer(publisher);
+
+  std::atomic<bool> done{false};
+  std::atomic<int> inconsistent{0};
+  std::atomic<int> reads{0};
+  std::thread reader_thread([&] {
+    StatusReader reader(name);
+    StatusReader::Snapshot snapshot;
+    while (!done) {
+      if (!reader.try_read(snapshot) || snapshot.tick == 0) {
+        continue;
+      }
+      ++reads;
+      // Tick n ran with tick == n - 1
+      Status expected = snapshot.tick % 2 == 1;
+      for (size_t id = 0; id < snapshot.statuses.size(); ++id) {
+        if (snapshot.statuses[id] != expected ||
+            snapshot.last_ticks[id] != snapshot.tick) {
+          ++inconsistent;
+        }
+      }
+    }
+  });
+  for (; tick < 20000; ++tick) {
+    tree.run();
+  }
+  done = true;
+  reader_thread.join();
+  ASSERT_EQ(inconsistent, 0);
+  ASSERT_GT(reads, 0);
+}
+
+// Opening a missing segment fails
+TEST(BehaviorTreeTest, StatusReaderMissingSegment) {
+  ASSERT_THROW(StatusReader(segment_name("missing")), std::system_error);
+}
@@ -81,4 +81,8 @@ TEST(StatusTest, StreamOutput) {
   std::stringstream ss_running;
   ss_running << running_status;
   ASSERT_EQ(ss_running.str(), "RUNNING");
+
+  std::stringstream ss_incomplete;
+  ss_incomplete << Status::Incomplete;
+  ASSERT_EQ(ss_incomplete.str(), "INCOMPLETE");
 }
@@ -0,0 +1,87 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+#include <memory_resource>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+// Leaves see the time sampled at the start of the tick and the tick counter
+TEST(BehaviorTreeTest, TickContextTimeAndCounter) {
+  auto clock = std::make_shared<SimulatedClock>();
+  std::vector<Clock::TimePoint> times;
+  std::vector<std::uint64_t> ticks;
+  auto record = [&](TickContext &context) {
+    times.push_back(context.now());
+    ticks.push_back(context.tick());
+    clock->advance(1ms);
+  };
+  BehaviorTree tree(sequence(action(record), action(record),
+                             condition([](TickContext &context) {
+                               auto *value = context.user_data<int>();
+                               return Status(value && *value == 7);
+                             })));
+  tree.set_clock(clock);
+  tree.set_user_data(7);
+
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(tree.run(), Status::Success);
+  auto start = Clock::TimePoint();
+  ASSERT_EQ(times, (std::vector<Clock::TimePoint>{start, start, start + 2ms,
+                                                  start + 2ms}));
+  ASSERT_EQ(ticks, (std::vector<std::uint64_t>{1, 1, 2, 2}));
+  ASSERT_EQ(tree.context().tick(), 2);
+
+  tree.set_user_data(std::string("other"));
+  ASSERT_EQ(tree.run(), Status::Failure);
+}
+
+// The scratch arena is reset after every tick and reuses its memory
+TEST(BehaviorTreeTest, TickContextScratchArena) {
+  std::size_t capacity = 0;
+  BehaviorTree tree(action([&](TickContext &context) {
+    ASSERT_EQ(context.scratch().used(), 0);
+    std::pmr::vector<int> values(&context.scratch());
+    for (int i = 0; i < 10000; ++i) {
+      values.push_back(i);
+    }
+    ASSERT_EQ(values.back(), 9999);
+    if (capacity == 0) {
+      capacity = context.scratch().capacity();
+    }
+    ASSERT_EQ(context.scratch().capacity(), capacity);
+  }));
+
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(tree.run(), Status::Success);
+  }
+  ASSERT_GT(capacity, 10000 * sizeof(int));
+  ASSERT_EQ(tree.context().tick(), 5);
+}
+
+// Leaves ticked outside a tree or on other threads get a context too
+TEST(BehaviorTreeTest, TickContextDetachedAndPrefetched) {
+  std::uint64_t seen = 0;
+  auto leaf = action([&](TickContext &context) { seen = context.tick(); });
+  ASSERT_EQ((*leaf)(), Status::Success);
+  ASSERT_EQ(seen, 1);
+
+  auto prefetched = std::make_shared<Condition>(
+      [&](TickContext &context) {
+        std::pmr::vector<int> scratch({1, 2, 3}, &context.scratch());
+        return Status(context.tick() == 3 && scratch.size() == 3);
+      },
+      "");
+  prefetched->set_prefetchable(true);
+  BehaviorTree tree(prefetched);
+  tree.set_prefetching(std::make_shared<ThreadPool>(2));
+  ASSERT_EQ(tree.run(), Status::Failure);
+  ASSERT_EQ(tree.run(), Status::Failure);
+  ASSERT_EQ(tree.run(), Status::Success);
+
+  FlatTree flat(sequence(leaf, leaf));
+  ASSERT_EQ(flat.run(), Status::Success);
+  ASSERT_EQ(flat.run(), Status::Success);
+  ASSERT_EQ(seen, 2);
+}
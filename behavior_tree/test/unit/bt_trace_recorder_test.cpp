@@ -0,0 +1,103 @@
+#include "../include/behavior_tree/bt_base.h"
+#include "../include/behavior_tree/trace_recorder.h"
+#include "stepping_clock.h"
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <sstream>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+namespace {
+
+size_t count(const std::string &text, const std::string &pattern) {
+  size_t found = 0;
+  for (auto pos = text.find(pattern); pos != std::string::npos;
+       pos = text.find(pattern, pos + 1)) {
+    ++found;
+  }
+  return found;
+}
+
+} // namespace
+
+// Every ticked node becomes a nested span with its type and status
+TEST(BehaviorTreeTest, TraceRecorderChromeTrace) {
+  auto recorder =
+      std::make_shared<TraceRecorder>(0, std::make_shared<SteppingClock>());
+  BehaviorTree tree(sequence(condition([] { return Status::Success; },
+                                       "Check \"lane\""),
+                             action([] {})));
+  tree.add_observer(recorder);
+  ASSERT_EQ(tree.run(), Status::Success);
+  ASSERT_EQ(recorder->ticks(), 1);
+
+  std::ostringstream out;
+  recorder->write_chrome_trace(out);
+  auto trace = out.str();
+  ASSERT_EQ(trace,
+            "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+            "{\"name\":\"sequence\",\"cat\":\"sequence\",\"ph\":\"B\","
+            "\"ts\":1000.000,\"pid\":1,\"tid\":1},\n"
+            "{\"name\":\"Check \\\"lane\\\"\",\"cat\":\"condition\",\"ph\":\"B\","
+            "\"ts\":2000.000,\"pid\":1,\"tid\":1},\n"
+            "{\"name\":\"Check \\\"lane\\\"\",\"cat\":\"condition\",\"ph\":\"E\","
+            "\"ts\":3000.000,\"pid\":1,\"tid\":1,"
+            "\"args\":{\"type\":\"condition\",\"status\":\"SUCCESS\"}},\n"
+            "{\"name\":\"action\",\"cat\":\"action\",\"ph\":\"B\","
+            "\"ts\":4000.000,\"pid\":1,\"tid\":1},\n"
+            "{\"name\":\"action\",\"cat\":\"action\",\"ph\":\"E\","
+            "\"ts\":5000.000,\"pid\":1,\"tid\":1,"
+            "\"args\":{\"type\":\"action\",\"status\":\"SUCCESS\"}},\n"
+            "{\"name\":\"sequence\",\"cat\":\"sequence\",\"ph\":\"E\","
+            "\"ts\":6000.000,\"pid\":1,\"tid\":1,"
+            "\"args\":{\"type\":\"sequence\",\"status\":\"SUCCESS\"}}\n"
+            "]}\n");
+}
+
+// In ring buffer mode only the latest ticks are kept
+TEST(BehaviorTreeTest, TraceRecorderRingBuffer) {
+  auto recorder = std::make_shared<TraceRecorder>(2);
+  int tick = 0;
+  BehaviorTree tree(condition([&tick] { return Status(++tick % 2 == 0); }));
+  tree.add_observer(recorder);
+  for (int i = 0; i < 5; ++i) {
+    tree.run();
+  }
+  ASSERT_EQ(recorder->ticks(), 2);
+
+  std::ostringstream out;
+  recorder->write_chrome_trace(out);
+  auto trace = out.str();
+  ASSERT_EQ(count(trace, "\"ph\":\"B\""), 2);
+  ASSERT_EQ(count(trace, "SUCCESS"), 1);
+  ASSERT_EQ(count(trace, "FAILURE"), 1);
+  // The latest tick failed
+  ASSERT_LT(trace.find("SUCCESS"), trace.find("FAILURE"));
+
+  recorder->clear();
+  ASSERT_EQ(recorder->ticks(), 0);
+}
+
+// Recorded ticks can be written after the tree is freed
+TEST(BehaviorTreeTest, TraceRecorderOutlivesTree) {
+  auto recorder =
+      std::make_shared<TraceRecorder>(0, std::make_shared<SteppingClock>());
+  {
+    BehaviorTree tree(condition([] { return Status::Success; }, "Freed"));
+    tree.add_observer(recorder);
+    ASSERT_EQ(tree.run(), Status::Success);
+  }
+
+  std::ostringstream out;
+  out << std::setprecision(2) << 1.2345 << ' ';
+  recorder->write_chrome_trace(out);
+  out << 1.2345;
+  auto trace = out.str();
+  ASSERT_EQ(count(trace, "\"name\":\"Freed\""), 2);
+  // The stream's format is restored
+  ASSERT_EQ(trace.substr(0, 4), "1.2 ");
+  ASSERT_EQ(trace.substr(trace.size() - 3), "1.2");
+}
@@ -0,0 +1,150 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+namespace {
+
+std::vector<TransitionEvent> drain(TransitionSubscription &subscription) {
+  std::vector<TransitionEvent> events;
+  TransitionEvent event;
+  while (subscription.pop(event)) {
+    events.push_back(event);
+  }
+  return events;
+}
+
+} // namespace
+
+// Only changes of a node's status are reported
+TEST(BehaviorTreeTest, TransitionStreamReportsChanges) {
+  Status input = Status::Running;
+  auto leaf = condition([&input] { return input; }, "leaf");
+  auto root = sequence("root", leaf);
+  BehaviorTree tree(root);
+  auto subscription = tree.subscribe();
+
+  tree.run();
+  auto events = drain(*subscription);
+  ASSERT_EQ(events.size(), 2);
+  ASSERT_EQ(subscription->node(events[0])->description, "leaf");
+  ASSERT_TRUE(events[0].initial);
+  ASSERT_EQ(events[0].to, Status::RUNNING);
+  ASSERT_EQ(subscription->node(events[1])->description, "root");
+  ASSERT_EQ(subscription->node(events[1])->type, "sequence");
+  auto unknown = events[1];
+  unknown.node = 2;
+  ASSERT_FALSE(subscription->node(unknown));
+
+  // Identical results produce no events
+  for (int i = 0; i < 10; ++i) {
+    tree.run();
+  }
+  ASSERT_TRUE(drain(*subscription).empty());
+
+  input = Status::Failure;
+  tree.run();
+  events = drain(*subscription);
+  ASSERT_EQ(events.size(), 2);
+  ASSERT_FALSE(events[0].initial);
+  ASSERT_EQ(events[0].from, Status::RUNNING);
+  ASSERT_EQ(events[0].to, Status::FAILURE);
+  ASSERT_EQ(events[0].tick, 12);
+
+  tree.unsubscribe(subscription);
+  input = Status::Success;
+  tree.run();
+  ASSERT_TRUE(drain(*subscription).empty());
+}
+
+// Subscribers only receive events of their subtree, and overflow is counted
+TEST(BehaviorTreeTest, TransitionStreamFiltersSubtree) {
+  int tick = 0;
+  auto left = condition([&tick] { return Status(tick % 2 == 0); }, "left");
+  auto right = sequence(condition([&tick] { return Status(tick % 3 == 0); }));
+  BehaviorTree tree(parallel(left, right));
+  auto subscription = tree.subscribe(right, 4);
+
+  for (; tick < 6; ++tick) {
+    tree.run();
+  }
+  TransitionEvent event;
+  size_t received = 0;
+  while (subscription->pop(event)) {
+    ASSERT_NE(subscription->node(event)->description, "left");
+    ++received;
+  }
+  // Each of the two nodes changes on ticks 1, 2, 4 and 5
+  ASSERT_EQ(received, 4);
+  ASSERT_EQ(subscription->dropped(), 4);
+}
+
+// Events can be consumed by another thread while the tree ticks
+TEST(BehaviorTreeTest, TransitionStreamConcurrentConsumer) {
+  constexpr int ticks = 100000;
+  int tick = 0;
+  BehaviorTree tree(condition([&tick] { return Status(tick % 2 == 0); }));
+  auto subscription = tree.subscribe(nullptr, ticks);
+
+  size_t out_of_order = 0;
+  std::thread consumer([&subscription, &out_of_order] {
+    TransitionEvent event;
+    for (std::uint64_t expected = 1; expected <= ticks;) {
+      if (subscription->pop(event)) {
+        auto to = expected % 2 == 1 ? Status::SUCCESS : Status::FAILURE;
+        out_of_order += event.tick != expected || event.to != to;
+        ++expected;
+      }
+    }
+  });
+  for (; tick < ticks; ++tick) {
+    tree.run();
+  }
+  consumer.join();
+  ASSERT_EQ(out_of_order, 0);
+  ASSERT_EQ(subscription->dropped(), 0);
+}
+
+// Events emitted before a new root are not labelled with the new nodes
+TEST(BehaviorTreeTest, TransitionStreamRejectsStaleEvents) {
+  BehaviorTree tree(condition([] { return Status::Success; }, "old"));
+  auto subscription = tree.subscribe();
+  tree.run();
+  TransitionEvent stale;
+  ASSERT_TRUE(subscription->pop(stale));
+  ASSERT_EQ(subscription->node(stale)->description, "old");
+
+  tree.set_root(condition([] { return Status::Failure; }, "new"));
+  ASSERT_FALSE(subscription->node(stale));
+  tree.run();
+  TransitionEvent event;
+  ASSERT_TRUE(subscription->pop(event));
+  ASSERT_EQ(event.node, stale.node);
+  ASSERT_NE(event.generation, stale.generation);
+  ASSERT_EQ(subscription->node(event)->description, "new");
+}
+
+// A whole-tree subscription follows the tree to its new root
+TEST(BehaviorTreeTest, TransitionStreamFollowsNewRoot) {
+  BehaviorTree tree(condition([] { return Status::Success; }));
+  auto subscription = tree.subscribe();
+  tree.run();
+  ASSERT_EQ(drain(*subscription).size(), 1);
+
+  auto root = sequence(condition([] { return Status::Failure; }, "new"));
+  std::weak_ptr<BehaviorNode> old_root = root;
+  tree.set_root(root);
+  tree.run();
+  tree.run();
+  auto events = drain(*subscription);
+  ASSERT_EQ(events.size(), 2);
+  ASSERT_EQ(subscription->node(events[0])->description, "new");
+
+  // The subscription does not keep a replaced root alive
+  root.reset();
+  tree.set_root(action([] {}));
+  ASSERT_TRUE(old_root.expired());
+}
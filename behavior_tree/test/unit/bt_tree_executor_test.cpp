@@ -0,0 +1,97 @@
+#include "../include/behavior_tree/bt_base.h"
+#include "../include/behavior_tree/tree_executor.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+// Trees tick at their own rates and never concurrently with themselves
+TEST(BehaviorTreeTest, TreeExecutorTicksPeriodically) {
+  constexpr int tree_count = 6;
+  std::atomic<int> ticks[tree_count] = {};
+  std::atomic<bool> overlapped{false};
+  TreeExecutor executor(2);
+  ASSERT_EQ(executor.size(), 2);
+
+  std::vector<TreeExecutor::TreeId> ids;
+  for (int i = 0; i < tree_count; ++i) {
+    auto running = std::make_shared<std::atomic<int>>(0);
+    auto tree = std::make_shared<BehaviorTree>(action([&, i, running] {
+      if (running->fetch_add(1) != 0) {
+        overlapped = true;
+      }
+      std::this_thread::sleep_for(100us);
+      ++ticks[i];
+      running->fetch_sub(1);
+    }));
+    ids.push_back(executor.add(tree, i < 3 ? 2ms : 10ms));
+  }
+  std::this_thread::sleep_for(200ms);
+
+  ASSERT_FALSE(overlapped);
+  for (int i = 0; i < tree_count; ++i) {
+    auto stats = executor.stats(ids[i]);
+    ASSERT_GT(stats.ticks, 0);
+    ASSERT_EQ(stats.last_status, Status::Success);
+    ASSERT_GE(stats.max_start_delay, Clock::Duration::zero());
+  }
+  // The fast trees are released more often than the slow ones
+  ASSERT_GT(executor.stats(ids[0]).ticks, executor.stats(ids[3]).ticks);
+  ASSERT_LE(ticks[3].load(), 25);
+}
+
+// A tree slower than its period misses deadlines and skips releases
+TEST(BehaviorTreeTest, TreeExecutorReportsLateness) {
+  TreeExecutor executor(1);
+  auto id = executor.add(std::make_shared<BehaviorTree>(action(
+                             [] { std::this_thread::sleep_for(5ms); })),
+                         1ms);
+  std::this_thread::sleep_for(50ms);
+
+  auto stats = executor.stats(id);
+  ASSERT_GT(stats.ticks, 0);
+  ASSERT_EQ(stats.deadline_misses, stats.ticks);
+  ASSERT_GT(stats.skipped_releases, 0);
+  ASSERT_GE(stats.max_lateness, 4ms);
+  ASSERT_GT(stats.mean_lateness(), Clock::Duration::zero());
+}
+
+// Removed trees are not ticked anymore
+TEST(BehaviorTreeTest, TreeExecutorRemove) {
+  std::atomic<int> ticks{0};
+  TreeExecutor executor(2);
+  auto id = executor.add(
+      std::make_shared<BehaviorTree>(action([&ticks] { ++ticks; })), 1ms);
+  std::this_thread::sleep_for(20ms);
+  executor.remove(id);
+  ASSERT_THROW(executor.stats(id), std::out_of_range);
+
+  // A tick in progress may still complete
+  std::this_thread::sleep_for(5ms);
+  auto stopped = ticks.load();
+  ASSERT_GT(stopped, 0);
+  std::this_thread::sleep_for(20ms);
+  ASSERT_EQ(ticks.load(), stopped);
+
+  ASSERT_THROW(executor.add(nullptr, 1ms), std::invalid_argument);
+  ASSERT_THROW(executor.add(std::make_shared<BehaviorTree>(action([] {})),
+                            Clock::Duration::zero()),
+               std::invalid_argument);
+}
+
+// The executor keeps real time when the default clock is simulated
+TEST(BehaviorTreeTest, TreeExecutorIgnoresSimulatedDefaultClock) {
+  set_default_clock(std::make_shared<SimulatedClock>());
+  TreeExecutor executor(1);
+  set_default_clock(nullptr);
+
+  std::atomic<int> ticks{0};
+  executor.add(std::make_shared<BehaviorTree>(action([&ticks] { ++ticks; })),
+               1ms);
+  std::this_thread::sleep_for(50ms);
+  ASSERT_GT(ticks.load(), 1);
+}
@@ -0,0 +1,71 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+// The unordered fallback learns to try the child which succeeds first
+TEST(BehaviorTreeTest, UnorderedFallbackPrefersSucceedingChild) {
+  size_t failing_visits = 0;
+  size_t succeeding_visits = 0;
+  auto node = unordered_fallback("Localization", condition([&failing_visits] {
+                                   ++failing_visits;
+                                   return Status::Failure;
+                                 }),
+                                 condition([&succeeding_visits] {
+                                   ++succeeding_visits;
+                                   return Status::Success;
+                                 }));
+  ASSERT_EQ(node->type(), "unordered_fallback");
+
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_EQ(failing_visits, 1);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ((*node)(), Status::Success);
+  }
+  ASSERT_EQ(failing_visits, 1);
+  ASSERT_EQ(succeeding_visits, 11);
+
+  auto unordered = std::static_pointer_cast<UnorderedComposite>(node);
+  ASSERT_EQ(unordered->order(), (std::vector<size_t>{1, 0}));
+  ASSERT_EQ(unordered->stats()[1].samples, 11);
+}
+
+// The unordered sequence learns to tick the child which fails first
+TEST(BehaviorTreeTest, UnorderedSequencePrefersFailingChild) {
+  size_t succeeding_visits = 0;
+  auto node = unordered_sequence(condition([&succeeding_visits] {
+                                   ++succeeding_visits;
+                                   return Status::Success;
+                                 }),
+                                 condition([] { return Status::Failure; }));
+
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ((*node)(), Status::Failure);
+  }
+  ASSERT_EQ(succeeding_visits, 1);
+}
+
+// A frozen order is kept regardless of the statistics
+TEST(BehaviorTreeTest, UnorderedFallbackFrozenOrder) {
+  size_t failing_visits = 0;
+  auto node = std::make_shared<UnorderedFallback>(
+      "", BehaviorNode::Children{condition([&failing_visits] {
+                                   ++failing_visits;
+                                   return Status::Failure;
+                                 }),
+                                 condition([] { return Status::Success; })});
+  node->freeze();
+
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ((*node)(), Status::Success);
+  }
+  ASSERT_EQ(failing_visits, 5);
+  ASSERT_EQ(node->order(), (std::vector<size_t>{0, 1}));
+
+  node->set_order({1, 0});
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_EQ(failing_visits, 5);
+  ASSERT_THROW(node->set_order({1, 1}), std::invalid_argument);
+}
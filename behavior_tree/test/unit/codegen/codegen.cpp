@@ -0,0 +1,66 @@
+#include "../include/behavior_tree/bt_base.h"
+#include "safety_tree.h"
+#include "safety_tree_generated.h"
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+namespace {
+
+bt_codegen::Options safety_options() {
+  bt_codegen::Options options;
+  options.name = "tick_safety_tree";
+  options.name_space = "safety";
+  return options;
+}
+
+std::string read_file(const std::string &path) {
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+} // namespace
+
+// The checked-in header is what the generator produces for the safety tree
+TEST(BehaviorTreeTest, CodegenHeaderIsUpToDate) {
+  safety::World world;
+  std::string path = __FILE__;
+  path = path.substr(0, path.find_last_of('/')) + "/safety_tree_generated.h";
+  ASSERT_EQ(bt_codegen::generate(safety::make_tree(world), safety_options()),
+            read_file(path));
+}
+
+// The generated function behaves exactly like the interpreted tree
+TEST(BehaviorTreeTest, CodegenMatchesInterpretedTree) {
+  safety::Fixture fixture;
+  auto mismatch = safety::tick_safety_tree_check(fixture, 2000);
+  ASSERT_TRUE(mismatch.empty()) << mismatch;
+  ASSERT_EQ(fixture.source_world.visits, fixture.leaves_world.visits);
+}
+
+// The generated test calls the check function of the generated header
+TEST(BehaviorTreeTest, CodegenTest) {
+  auto test = bt_codegen::generate_test("safety_tree_generated.h",
+                                        "safety_tree.h", "safety::Fixture",
+                                        safety_options(), 500);
+  ASSERT_NE(test.find("#include \"safety_tree_generated.h\""),
+            std::string::npos);
+  ASSERT_NE(test.find("TEST(GeneratedTreeTest, tick_safety_tree)"),
+            std::string::npos);
+  ASSERT_NE(test.find("safety::tick_safety_tree_check(fixture, 500)"),
+            std::string::npos);
+}
+
+// A leaf function cannot implement both an action and a condition
+TEST(BehaviorTreeTest, CodegenRejectsConflictingLeaves) {
+  auto tree = sequence(condition([] { return Status::Success; }, "Go"),
+                       action([] {}, "Go"));
+  ASSERT_THROW(bt_codegen::generate(tree), std::invalid_argument);
+  ASSERT_THROW(bt_codegen::generate(nullptr), std::invalid_argument);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../include/behavior_tree/bt_base.h"
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace safety {
+
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+// Inputs and side effects of the safety tree.
+struct World {
+  std::vector<Status> inputs = std::vector<Status>(5, Status::Failure);
+  std::vector<size_t> visits = std::vector<size_t>(7, 0);
+  bool brake_fault = false;
+};
+
+// Leaf functions called by the generated code.
+struct Leaves {
+  World &world;
+
+  Status visit(size_t index) {
+    ++world.visits[index];
+    return world.inputs[index];
+  }
+
+  Status battery_ok() { return visit(0); }
+  Status obstacle_ahead() { return visit(1); }
+  Status path_clear() { return visit(2); }
+  Status at_goal() { return visit(3); }
+  Status operator_override() { return visit(4); }
+  void brake() {
+    ++world.visits[5];
+    if (world.brake_fault) {
+      throw std::runtime_error("brake fault");
+    }
+  }
+  void drive() { ++world.visits[6]; }
+};
+
+// Builds the interpreted tree on top of the same leaf functions.
+inline BehaviorPtr make_tree(World &world) {
+  auto leaves = std::make_shared<Leaves>(Leaves{world});
+  auto input = [leaves](Status (Leaves::*check)(), const std::string &name) {
+    return condition([leaves, check] { return ((*leaves).*check)(); }, name);
+  };
+  auto [latch, unlatch] =
+      latch_and_unlatch(input(&Leaves::battery_ok, "Battery OK"));
+  auto brake = action([leaves] { leaves->brake(); }, "Brake");
+  // clang-format off
+  return
+  fallback(
+    sequence_memory(
+      latch,
+      not_(input(&Leaves::obstacle_ahead, "Obstacle ahead")),
+      if_then_else("",
+        input(&Leaves::path_clear, "Path clear"),
+        action([leaves] { leaves->drive(); }, "Drive"),
+        brake
+      ),
+      input(&Leaves::at_goal, "At goal")
+    ),
+    parallel(
+      try_else("", input(&Leaves::operator_override, "Operator override"),
+               unlatch),
+      fallback_memory(
+        skipper(input(&Leaves::path_clear, "Path clear"), brake),
+        if_then("", input(&Leaves::obstacle_ahead, "Obstacle ahead"), brake)
+      )
+    )
+  );
+  // clang-format on
+}
+
+// Ticks the interpreted and the generated tree with identical random inputs.
+struct Fixture {
+  World source_world;
+  World leaves_world;
+  BehaviorPtr source = make_tree(source_world);
+  Leaves leaves{leaves_world};
+  std::mt19937 random{42};
+
+  void prepare(int tick) {
+    std::uniform_int_distribution<int> state(0, 2);
+    for (size_t i = 0; i < source_world.inputs.size(); ++i) {
+      Status input = Status::State(state(random));
+      source_world.inputs[i] = input;
+      leaves_world.inputs[i] = input;
+    }
+    source_world.brake_fault = leaves_world.brake_fault = tick % 7 == 0;
+  }
+};
+
+} // namespace safety
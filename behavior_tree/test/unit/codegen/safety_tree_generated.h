@@ -0,0 +1,222 @@
+// Generated by bt_codegen. Do not edit.
+#pragma once
+
+#include <behavior_tree/nodes/behavior_node.h>
+#include <behavior_tree/nodes/status.h>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace safety {
+
+/// State of the memory and latch nodes ticked by tick_safety_tree().
+struct tick_safety_tree_state {
+  /// sequence_memory
+  std::uint32_t n1_current = 0;
+  /// latch "Latching Battery OK"
+  bool n2_latched = false;
+  evo::behavior::Status::State n2_result = evo::behavior::Status::FAILURE;
+  /// fallback_memory
+  std::uint32_t n15_current = 0;
+};
+
+/**
+ * Ticks the tree. Leaves must provide:
+ *   evo::behavior::Status at_goal();
+ *   evo::behavior::Status battery_ok();
+ *   void brake();
+ *   void drive();
+ *   evo::behavior::Status obstacle_ahead();
+ *   evo::behavior::Status operator_override();
+ *   evo::behavior::Status path_clear();
+ */
+template <class Leaves>
+evo::behavior::Status tick_safety_tree(tick_safety_tree_state &state, Leaves &leaves) {
+  using evo::behavior::Status;
+  (void)state;
+  Status result = Status::Failure;
+  // fallback
+  result = Status::Failure;
+  if (result == Status::Failure) {
+    // sequence_memory
+    result = Status::Success;
+    if (result == Status::Success && state.n1_current <= 0) {
+      // latch "Latching Battery OK"
+      if (!state.n2_latched) {
+        // condition "Battery OK"
+        try {
+          result = leaves.battery_ok();
+        } catch (...) {
+          result = Status::Failure;
+        }
+        state.n2_result = result;
+        state.n2_latched = true;
+      }
+      result = state.n2_result;
+      if (result == Status::Success) {
+        state.n1_current = 1;
+      }
+    }
+    if (result == Status::Success && state.n1_current <= 1) {
+      // not "Inverting Obstacle ahead"
+      // condition "Obstacle ahead"
+      try {
+        result = leaves.obstacle_ahead();
+      } catch (...) {
+        result = Status::Failure;
+      }
+      if (result != Status::Running) {
+        result = result == Status::Success ? Status::Failure : Status::Success;
+      }
+      if (result == Status::Success) {
+        state.n1_current = 2;
+      }
+    }
+    if (result == Status::Success && state.n1_current <= 2) {
+      // if_then_else
+      // condition "Path clear"
+      try {
+        result = leaves.path_clear();
+      } catch (...) {
+        result = Status::Failure;
+      }
+      if (result == Status::Success) {
+        // action "Drive"
+        try {
+          leaves.drive();
+          result = Status::Success;
+        } catch (...) {
+          result = Status::Failure;
+        }
+      } else if (result == Status::Failure) {
+        // action "Brake"
+        try {
+          leaves.brake();
+          result = Status::Success;
+        } catch (...) {
+          result = Status::Failure;
+        }
+      }
+      if (result == Status::Success) {
+        state.n1_current = 3;
+      }
+    }
+    if (result == Status::Success && state.n1_current <= 3) {
+      // condition "At goal"
+      try {
+        result = leaves.at_goal();
+      } catch (...) {
+        result = Status::Failure;
+      }
+      if (result == Status::Success) {
+        state.n1_current = 4;
+      }
+    }
+    if (result == Status::Success) {
+      state.n1_current = 0;
+    }
+  }
+  if (result == Status::Failure) {
+    // parallel
+    bool r0_running = false;
+    bool r0_failed = false;
+    if (!r0_running) {
+      // try_else
+      // condition "Operator override"
+      try {
+        result = leaves.operator_override();
+      } catch (...) {
+        result = Status::Failure;
+      }
+      if (result == Status::Failure) {
+        // action "Unlatching Latching Battery OK"
+        state.n2_latched = false;
+        result = Status::Success;
+      }
+      r0_running = result == Status::Running;
+      r0_failed = r0_failed || result == Status::Failure;
+    }
+    if (!r0_running) {
+      // fallback_memory
+      result = Status::Failure;
+      if (result == Status::Failure && state.n15_current <= 0) {
+        // skipper
+        result = Status::Running;
+        if (result == Status::Running) {
+          // condition "Path clear"
+          try {
+            result = leaves.path_clear();
+          } catch (...) {
+            result = Status::Failure;
+          }
+        }
+        if (result == Status::Running) {
+          // action "Brake"
+          try {
+            leaves.brake();
+            result = Status::Success;
+          } catch (...) {
+            result = Status::Failure;
+          }
+        }
+        if (result == Status::Failure) {
+          state.n15_current = 1;
+        }
+      }
+      if (result == Status::Failure && state.n15_current <= 1) {
+        // if_then
+        // condition "Obstacle ahead"
+        try {
+          result = leaves.obstacle_ahead();
+        } catch (...) {
+          result = Status::Failure;
+        }
+        if (result == Status::Success) {
+          // action "Brake"
+          try {
+            leaves.brake();
+            result = Status::Success;
+          } catch (...) {
+            result = Status::Failure;
+          }
+        } else if (result == Status::Failure) {
+          result = Status::Success;
+        }
+        if (result == Status::Failure) {
+          state.n15_current = 2;
+        }
+      }
+      if (result == Status::Failure) {
+        state.n15_current = 0;
+      }
+      r0_running = result == Status::Running;
+      r0_failed = r0_failed || result == Status::Failure;
+    }
+    result = r0_running ? Status::Running
+        : r0_failed ? Status::Failure : Status::Success;
+  }
+  return result;
+}
+
+/**
+ * Ticks fixture.source and tick_safety_tree() side by side and returns a description of
+ * the first tick at which their statuses differ, or an empty string.
+ */
+template <class Fixture>
+std::string tick_safety_tree_check(Fixture &fixture, int ticks) {
+  tick_safety_tree_state state;
+  for (int tick = 0; tick < ticks; ++tick) {
+    fixture.prepare(tick);
+    evo::behavior::Status expected = (*fixture.source)();
+    evo::behavior::Status actual = tick_safety_tree(state, fixture.leaves);
+    if (expected != actual) {
+      std::ostringstream mismatch;
+      mismatch << "tick " << tick << ": expected " << expected
+               << ", got " << actual;
+      return mismatch.str();
+    }
+  }
+  return {};
+}
+
+} // namespace safety
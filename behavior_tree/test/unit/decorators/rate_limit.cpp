@@ -0,0 +1,82 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+using namespace std::chrono_literals;
+
+// The throttle node ticks its child at most once per period
+TEST(BehaviorTreeTest, Throttle) {
+  auto clock = std::make_shared<SimulatedClock>();
+  size_t visits = 0;
+  Status result = Status::Success;
+  auto node = throttle(condition([&] {
+                         ++visits;
+                         return result;
+                       }, "Route Feasible"),
+                       100ms, clock);
+  ASSERT_EQ(node->type(), "throttle");
+  ASSERT_EQ(node->description(), "Throttling Route Feasible");
+
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_EQ(visits, 1);
+
+  // The last status is returned until the period passes
+  result = Status::Failure;
+  clock->advance(99ms);
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_EQ(visits, 1);
+
+  clock->advance(1ms);
+  ASSERT_EQ((*node)(), Status::Failure);
+  ASSERT_EQ(visits, 2);
+
+  // Reset lets the child be ticked right away
+  node->reset();
+  ASSERT_EQ((*node)(), Status::Failure);
+  ASSERT_EQ(visits, 3);
+}
+
+// The cached node reuses terminal statuses until they expire
+TEST(BehaviorTreeTest, Cached) {
+  auto clock = std::make_shared<SimulatedClock>();
+  size_t visits = 0;
+  Status result = Status::Success;
+  auto node = cached(condition([&] {
+                       ++visits;
+                       return result;
+                     }),
+                     1s, clock);
+
+  ASSERT_EQ((*node)(), Status::Success);
+  result = Status::Failure;
+  clock->advance(500ms);
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_EQ(visits, 1);
+
+  clock->advance(500ms);
+  ASSERT_EQ((*node)(), Status::Failure);
+  ASSERT_EQ(visits, 2);
+}
+
+// The cached node never caches Status::Running
+TEST(BehaviorTreeTest, CachedForwardsRunning) {
+  auto clock = std::make_shared<SimulatedClock>();
+  size_t visits = 0;
+  Status result = Status::Running;
+  auto node = cached(condition([&] {
+                       ++visits;
+                       return result;
+                     }),
+                     1s, clock);
+
+  ASSERT_EQ((*node)(), Status::Running);
+  ASSERT_EQ((*node)(), Status::Running);
+  ASSERT_EQ(visits, 2);
+
+  result = Status::Success;
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_EQ(visits, 3);
+}
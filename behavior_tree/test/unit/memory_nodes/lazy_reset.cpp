@@ -0,0 +1,77 @@
+#include "../include/behavior_tree/bt_base.h"
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace evo::behavior;
+using namespace evo::behavior::bt_factory;
+
+// A leaf node which counts how many times it has been reset.
+class ResetCounter : public BehaviorNode {
+public:
+  explicit ResetCounter(size_t &resets)
+      : BehaviorNode("reset_counter", ""), resets_(resets) {}
+
+  Status operator()() override { return Status::Success; }
+
+  void reset() override {
+    BehaviorNode::reset();
+    ++resets_;
+  }
+
+private:
+  size_t &resets_;
+};
+
+// Resetting a memory node must not walk its subtree right away
+TEST(BehaviorTreeTest, LazyResetDoesNotWalkSubtree) {
+  size_t resets = 0;
+  auto counter = std::make_shared<ResetCounter>(resets);
+  auto node = sequence_memory(sequence(sequence(counter)));
+
+  node->reset();
+  ASSERT_EQ(resets, 0);
+
+  // The pending reset reaches the leaf when it is ticked
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_EQ(resets, 1);
+}
+
+// Completion of the outer memory sequence restarts the nested one
+TEST(BehaviorTreeTest, LazyResetRestartsNestedMemoryNode) {
+  size_t first_visits = 0;
+  bool second_done = false;
+  auto first = condition([&first_visits] {
+    ++first_visits;
+    return Status::Success;
+  });
+  auto second = condition(
+      [&second_done] { return second_done ? Status::Success : Status::Running; });
+  auto node = sequence_memory(sequence_memory(first, second));
+
+  ASSERT_EQ((*node)(), Status::Running);
+  ASSERT_EQ(first_visits, 1);
+
+  // The nested node remembers its position while running
+  second_done = true;
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_EQ(first_visits, 1);
+
+  // After the outer node completes, the nested node starts over
+  second_done = false;
+  ASSERT_EQ((*node)(), Status::Running);
+  ASSERT_EQ(first_visits, 2);
+}
+
+// A pending reset reaches a node only once
+TEST(BehaviorTreeTest, LazyResetAppliesOnce) {
+  size_t resets = 0;
+  auto counter = std::make_shared<ResetCounter>(resets);
+  auto node = fallback_memory(sequence(counter), condition([] {
+                                return Status::Failure;
+                              }));
+
+  node->reset();
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_EQ((*node)(), Status::Success);
+  ASSERT_EQ(resets, 1);
+}
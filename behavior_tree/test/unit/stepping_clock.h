@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../include/behavior_tree/clock.h"
+
+namespace evo::behavior {
+
+// A clock which advances by one millisecond every time it is read, so that
+// every recorded duration is known in advance.
+class SteppingClock : public Clock {
+public:
+  TimePoint now() const override {
+    return time_ += std::chrono::milliseconds(1);
+  }
+
+private:
+  mutable TimePoint time_;
+};
+
+} // namespace evo::behavior